@@ -16,6 +16,7 @@
 
 #include "core/FileStream.hpp"
 #include "FileClassifier.h"
+#include "ParkFile.h"
 #include "rct12/SawyerChunkReader.h"
 
 extern "C"
@@ -24,6 +25,7 @@ extern "C"
     #include "util/sawyercoding.h"
 }
 
+static bool TryClassifyAsPark(IStream * stream, ClassifiedFile * result);
 static bool TryClassifyAsS6(IStream * stream, ClassifiedFile * result);
 static bool TryClassifyAsS4(IStream * stream, ClassifiedFile * result);
 static bool TryClassifyAsTD4_TD6(IStream * stream, ClassifiedFile * result);
@@ -48,6 +50,12 @@ bool TryClassifyFile(IStream * stream, ClassifiedFile * result)
     //      between them is to decode it. Decoding however is currently not protected
     //      against invalid compression data for that decoding algorithm and will crash.
 
+    // Native park detection
+    if (TryClassifyAsPark(stream, result))
+    {
+        return true;
+    }
+
     // S6 detection
     if (TryClassifyAsS6(stream, result))
     {
@@ -69,6 +77,38 @@ bool TryClassifyFile(IStream * stream, ClassifiedFile * result)
     return false;
 }
 
+static bool TryClassifyAsPark(IStream * stream, ClassifiedFile * result)
+{
+    if (!ParkFile::IsParkFile(stream))
+    {
+        return false;
+    }
+
+    uint64 originalPosition = stream->GetPosition();
+    try
+    {
+        rct_s6_header header;
+        rct_s6_info info;
+        ParkFile::ReadMeta(stream, &header, &info);
+        stream->SetPosition(originalPosition);
+        if (header.type == S6_TYPE_SAVEDGAME)
+        {
+            result->Type = FILE_TYPE::SAVED_GAME;
+        }
+        else if (header.type == S6_TYPE_SCENARIO)
+        {
+            result->Type = FILE_TYPE::SCENARIO;
+        }
+        result->Version = header.version;
+        return true;
+    }
+    catch (const Exception &)
+    {
+        stream->SetPosition(originalPosition);
+    }
+    return false;
+}
+
 static bool TryClassifyAsS6(IStream * stream, ClassifiedFile * result)
 {
     try
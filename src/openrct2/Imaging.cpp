@@ -285,6 +285,16 @@ namespace Imaging
     }
 }
 
+struct image_io_png_stream
+{
+    png_structp     png_ptr;
+    png_infop       info_ptr;
+    png_colorp      palette;
+    FileStream *    fs;
+    sint32          rowsRemaining;
+    bool            failed;
+};
+
 extern "C"
 {
     bool image_io_png_read(uint8 * * pixels, uint32 * width, uint32 * height, const utf8 * path)
@@ -301,4 +311,126 @@ extern "C"
     {
         return Imaging::PngWrite32bpp(width, height, pixels, path);
     }
+
+    image_io_png_stream * image_io_png_stream_open(const utf8 * path, sint32 width, sint32 height, const rct_palette * palette)
+    {
+        png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, Imaging::PngError, Imaging::PngWarning);
+        if (png_ptr == nullptr)
+        {
+            return nullptr;
+        }
+
+        png_infop info_ptr = png_create_info_struct(png_ptr);
+        if (info_ptr == nullptr)
+        {
+            png_destroy_write_struct(&png_ptr, (png_infopp)nullptr);
+            return nullptr;
+        }
+
+        auto stream = Memory::Allocate<image_io_png_stream>();
+        stream->png_ptr = png_ptr;
+        stream->info_ptr = info_ptr;
+        stream->palette = (png_colorp)png_malloc(png_ptr, PNG_MAX_PALETTE_LENGTH * sizeof(png_color));
+        stream->fs = nullptr;
+        stream->rowsRemaining = height;
+        stream->failed = false;
+
+        for (int i = 0; i < 256; i++)
+        {
+            const rct_palette_entry *entry = &palette->entries[i];
+            stream->palette[i].blue = entry->blue;
+            stream->palette[i].green = entry->green;
+            stream->palette[i].red = entry->red;
+        }
+        png_set_PLTE(png_ptr, info_ptr, stream->palette, PNG_MAX_PALETTE_LENGTH);
+
+        try
+        {
+            stream->fs = new FileStream(path, FILE_MODE_WRITE);
+            png_set_write_fn(png_ptr, stream->fs, Imaging::PngWriteData, Imaging::PngFlush);
+
+            // Set error handler
+            if (setjmp(png_jmpbuf(png_ptr)))
+            {
+                throw Exception("PNG ERROR");
+            }
+
+            // Write header
+            png_set_IHDR(
+                png_ptr, info_ptr, width, height, 8,
+                PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT
+            );
+            png_byte transparentIndex = 0;
+            png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
+            png_write_info(png_ptr, info_ptr);
+        }
+        catch (Exception)
+        {
+            stream->failed = true;
+            image_io_png_stream_close(stream);
+            return nullptr;
+        }
+        return stream;
+    }
+
+    bool image_io_png_stream_write_rows(image_io_png_stream * stream, const uint8 * bits, sint32 numRows, sint32 stride)
+    {
+        if (stream->failed || numRows > stream->rowsRemaining)
+        {
+            stream->failed = true;
+            return false;
+        }
+
+        try
+        {
+            // Set error handler
+            if (setjmp(png_jmpbuf(stream->png_ptr)))
+            {
+                throw Exception("PNG ERROR");
+            }
+
+            for (sint32 y = 0; y < numRows; y++)
+            {
+                png_write_row(stream->png_ptr, (png_bytep)bits);
+                bits += stride;
+            }
+            stream->rowsRemaining -= numRows;
+        }
+        catch (Exception)
+        {
+            stream->failed = true;
+        }
+        return !stream->failed;
+    }
+
+    bool image_io_png_stream_close(image_io_png_stream * stream)
+    {
+        if (!stream->failed && stream->rowsRemaining == 0)
+        {
+            try
+            {
+                // Set error handler
+                if (setjmp(png_jmpbuf(stream->png_ptr)))
+                {
+                    throw Exception("PNG ERROR");
+                }
+                png_write_end(stream->png_ptr, nullptr);
+            }
+            catch (Exception)
+            {
+                stream->failed = true;
+            }
+        }
+        else
+        {
+            stream->failed = true;
+        }
+
+        bool result = !stream->failed;
+        png_free(stream->png_ptr, stream->palette);
+        png_destroy_write_struct(&stream->png_ptr, &stream->info_ptr);
+        delete stream->fs;
+        Memory::Free(stream);
+        return result;
+    }
 }
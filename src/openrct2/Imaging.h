@@ -34,9 +34,20 @@ namespace Imaging
 extern "C"
 {
 #endif
+    typedef struct image_io_png_stream image_io_png_stream;
+
     bool image_io_png_read(uint8 * * pixels, uint32 * width, uint32 * height, const utf8 * path);
     bool image_io_png_write(const rct_drawpixelinfo * dpi, const rct_palette * palette, const utf8 * path);
     bool image_io_png_write_32bpp(sint32 width, sint32 height, const void * pixels, const utf8 * path);
+
+    /**
+     * Writes a paletted PNG a few rows at a time so the full image never has to be held in memory.
+     * Rows must be written top to bottom. Close returns false if the stream failed at any point or
+     * fewer than height rows were written.
+     */
+    image_io_png_stream * image_io_png_stream_open(const utf8 * path, sint32 width, sint32 height, const rct_palette * palette);
+    bool image_io_png_stream_write_rows(image_io_png_stream * stream, const uint8 * bits, sint32 numRows, sint32 stride);
+    bool image_io_png_stream_close(image_io_png_stream * stream);
 #ifdef __cplusplus
 }
 #endif
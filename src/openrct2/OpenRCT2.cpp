@@ -50,6 +50,7 @@ extern "C"
     #include "rct1.h"
     #include "rct2.h"
     #include "rct2/interop.h"
+    #include "scenario/scenario.h"
 }
 
 // The game update inverval in milliseconds, (1000 / 40fps) = 25ms
@@ -306,6 +307,7 @@ extern "C"
 
     void openrct2_dispose()
     {
+        scenario_autosave_wait();
         network_close();
         http_dispose();
         language_close_all();
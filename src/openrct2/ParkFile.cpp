@@ -0,0 +1,335 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <cstddef>
+#include <zlib.h>
+#include "core/Exception.hpp"
+#include "core/IStream.hpp"
+#include "core/Math.hpp"
+#include "core/Memory.hpp"
+#include "ParkFile.h"
+
+struct SectionRange
+{
+    size_t Offset;
+    size_t Length;
+};
+
+// Packed objects are the only section without a fixed length, the limit only guards against corrupt files
+constexpr uint64 MAX_PACKED_OBJECTS_LENGTH = 256 * 1024 * 1024;
+
+#define S6_RANGE(first, last) { offsetof(rct_s6_data, first), offsetof(rct_s6_data, last) - offsetof(rct_s6_data, first) }
+
+/**
+ * Gets the parts of rct_s6_data that are stored in the given section, in the order they are stored.
+ */
+static std::vector<SectionRange> GetSectionRanges(uint32 id)
+{
+    switch (id) {
+    case PARK_FILE_SECTION::META:
+        return { { 0, offsetof(rct_s6_data, objects) } };
+    case PARK_FILE_SECTION::OBJECTS:
+        return { S6_RANGE(objects, elapsed_months) };
+    case PARK_FILE_SECTION::PARK:
+    {
+        size_t ridesEnd = offsetof(rct_s6_data, rides) + sizeof(rct_s6_data::rides);
+        return {
+            S6_RANGE(elapsed_months, map_elements),
+            S6_RANGE(next_free_map_element_pointer_index, sprites),
+            S6_RANGE(park_name, rides),
+            { ridesEnd, sizeof(rct_s6_data) - ridesEnd }
+        };
+    }
+    case PARK_FILE_SECTION::MAP:
+        return { S6_RANGE(map_elements, next_free_map_element_pointer_index) };
+    case PARK_FILE_SECTION::SPRITES:
+        return { S6_RANGE(sprites, park_name) };
+    case PARK_FILE_SECTION::RIDES:
+        return { { offsetof(rct_s6_data, rides), sizeof(rct_s6_data::rides) } };
+    default:
+        return { };
+    }
+}
+
+static size_t GetSectionLength(const std::vector<SectionRange> &ranges)
+{
+    size_t length = 0;
+    for (const SectionRange &range : ranges)
+    {
+        length += range.Length;
+    }
+    return length;
+}
+
+static ParkFileSectionEntry CompressSection(uint32 id, const void * data, size_t length, std::vector<uint8> &compressedData)
+{
+    ParkFileSectionEntry entry = { 0 };
+    entry.Id = id;
+    entry.Length = length;
+    if (length == 0)
+    {
+        entry.Compression = PARK_FILE_COMPRESSION::NONE;
+        compressedData.clear();
+    }
+    else
+    {
+        // Favour speed, the sections are mostly sparse and compress well anyway
+        uLongf compressedLength = compressBound((uLong)length);
+        compressedData.resize(compressedLength);
+        if (compress2(compressedData.data(), &compressedLength, (const Bytef *)data, (uLong)length, Z_BEST_SPEED) != Z_OK)
+        {
+            throw IOException("Unable to compress park file section.");
+        }
+        compressedData.resize(compressedLength);
+        entry.Compression = PARK_FILE_COMPRESSION::ZLIB;
+    }
+    entry.CompressedLength = compressedData.size();
+    entry.Crc32 = (uint32)crc32(0, compressedData.data(), (uInt)compressedData.size());
+    return entry;
+}
+
+/**
+ * Checks that the section lies within the stream and has the length expected for its id, so that
+ * nothing read from a corrupt file is used to size an allocation.
+ */
+static void ValidateSectionEntry(const ParkFileSectionEntry &entry, uint64 parkFileLength)
+{
+    if (entry.Offset > parkFileLength || entry.CompressedLength > parkFileLength - entry.Offset)
+    {
+        throw IOException("Park file is truncated.");
+    }
+
+    if (entry.Id == PARK_FILE_SECTION::PACKED_OBJECTS)
+    {
+        if (entry.Length > MAX_PACKED_OBJECTS_LENGTH)
+        {
+            throw IOException("Park file section is the wrong size.");
+        }
+    }
+    else if (entry.Id < PARK_FILE_SECTION::COUNT)
+    {
+        if (entry.Length != GetSectionLength(GetSectionRanges(entry.Id)))
+        {
+            throw IOException("Park file section is the wrong size.");
+        }
+    }
+}
+
+static std::vector<ParkFileSectionEntry> ReadSectionTable(IStream * stream)
+{
+    uint64 parkFileStart = stream->GetPosition();
+    uint64 parkFileLength = stream->GetLength() - parkFileStart;
+
+    auto header = stream->ReadValue<ParkFileHeader>();
+    if (header.Magic != ParkFile::MAGIC)
+    {
+        throw IOException("Not a park file.");
+    }
+    if (header.Version > ParkFile::VERSION)
+    {
+        throw IOException("Park file version is not supported.");
+    }
+    if (header.NumSections * sizeof(ParkFileSectionEntry) > parkFileLength - sizeof(ParkFileHeader))
+    {
+        throw IOException("Park file is truncated.");
+    }
+
+    std::vector<ParkFileSectionEntry> entries(header.NumSections);
+    stream->Read(entries.data(), entries.size() * sizeof(ParkFileSectionEntry));
+    for (const ParkFileSectionEntry &entry : entries)
+    {
+        ValidateSectionEntry(entry, parkFileLength);
+    }
+    return entries;
+}
+
+static const ParkFileSectionEntry * FindSection(const std::vector<ParkFileSectionEntry> &entries, uint32 id)
+{
+    for (const ParkFileSectionEntry &entry : entries)
+    {
+        if (entry.Id == id)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+static std::vector<uint8> ReadSection(IStream * stream, uint64 parkFileStart, const ParkFileSectionEntry &entry)
+{
+    std::vector<uint8> compressedData((size_t)entry.CompressedLength);
+    stream->SetPosition(parkFileStart + entry.Offset);
+    stream->Read(compressedData.data(), compressedData.size());
+    if ((uint32)crc32(0, compressedData.data(), (uInt)compressedData.size()) != entry.Crc32)
+    {
+        throw IOException("Park file section is corrupt.");
+    }
+
+    switch (entry.Compression) {
+    case PARK_FILE_COMPRESSION::NONE:
+        if (entry.CompressedLength != entry.Length)
+        {
+            throw IOException("Park file section is corrupt.");
+        }
+        return compressedData;
+    case PARK_FILE_COMPRESSION::ZLIB:
+    {
+        std::vector<uint8> data((size_t)entry.Length);
+        uLongf length = (uLongf)data.size();
+        if (uncompress(data.data(), &length, compressedData.data(), (uLong)compressedData.size()) != Z_OK ||
+            length != data.size())
+        {
+            throw IOException("Park file section is corrupt.");
+        }
+        return data;
+    }
+    default:
+        throw IOException("Park file section uses an unsupported compression.");
+    }
+}
+
+namespace ParkFile
+{
+    bool IsParkFile(IStream * stream)
+    {
+        uint64 originalPosition = stream->GetPosition();
+        uint32 magic = 0;
+        bool result = stream->TryRead(&magic, sizeof(magic)) == sizeof(magic) && magic == MAGIC;
+        stream->SetPosition(originalPosition);
+        return result;
+    }
+
+    void Write(IStream * stream, const rct_s6_data * s6, const void * packedObjects, size_t packedObjectsLength)
+    {
+        std::vector<ParkFileSectionEntry> entries;
+        std::vector<std::vector<uint8>> sectionData(PARK_FILE_SECTION::COUNT);
+        std::vector<uint8> buffer;
+        for (uint32 id = 0; id < PARK_FILE_SECTION::COUNT; id++)
+        {
+            if (id == PARK_FILE_SECTION::PACKED_OBJECTS)
+            {
+                entries.push_back(CompressSection(id, packedObjects, packedObjectsLength, sectionData[id]));
+                continue;
+            }
+
+            auto ranges = GetSectionRanges(id);
+            if (ranges.size() == 1)
+            {
+                const uint8 * data = (const uint8 *)s6 + ranges[0].Offset;
+                entries.push_back(CompressSection(id, data, ranges[0].Length, sectionData[id]));
+            }
+            else
+            {
+                buffer.clear();
+                for (const SectionRange &range : ranges)
+                {
+                    const uint8 * data = (const uint8 *)s6 + range.Offset;
+                    buffer.insert(buffer.end(), data, data + range.Length);
+                }
+                entries.push_back(CompressSection(id, buffer.data(), buffer.size(), sectionData[id]));
+            }
+        }
+
+        // Section data follows the table in section order
+        uint64 offset = sizeof(ParkFileHeader) + entries.size() * sizeof(ParkFileSectionEntry);
+        for (ParkFileSectionEntry &entry : entries)
+        {
+            entry.Offset = offset;
+            offset += entry.CompressedLength;
+        }
+
+        ParkFileHeader header = { 0 };
+        header.Magic = MAGIC;
+        header.Version = VERSION;
+        header.NumSections = (uint16)entries.size();
+        stream->WriteValue(header);
+        stream->Write(entries.data(), entries.size() * sizeof(ParkFileSectionEntry));
+        for (const std::vector<uint8> &data : sectionData)
+        {
+            stream->Write(data.data(), data.size());
+        }
+    }
+
+    void Read(IStream * stream, rct_s6_data * s6, uint32 sectionMask, std::vector<uint8> * packedObjects)
+    {
+        uint64 parkFileStart = stream->GetPosition();
+        auto entries = ReadSectionTable(stream);
+
+        uint64 parkFileLength = sizeof(ParkFileHeader) + entries.size() * sizeof(ParkFileSectionEntry);
+        for (const ParkFileSectionEntry &entry : entries)
+        {
+            parkFileLength = Math::Max(parkFileLength, entry.Offset + entry.CompressedLength);
+        }
+
+        for (uint32 id = 0; id < PARK_FILE_SECTION::COUNT; id++)
+        {
+            if (!(sectionMask & (1 << id)))
+            {
+                continue;
+            }
+
+            const ParkFileSectionEntry * entry = FindSection(entries, id);
+            if (entry == nullptr)
+            {
+                throw IOException("Park file is missing a section.");
+            }
+
+            auto data = ReadSection(stream, parkFileStart, *entry);
+            if (id == PARK_FILE_SECTION::PACKED_OBJECTS)
+            {
+                if (packedObjects != nullptr)
+                {
+                    *packedObjects = std::move(data);
+                }
+                continue;
+            }
+
+            auto ranges = GetSectionRanges(id);
+            if (data.size() != GetSectionLength(ranges))
+            {
+                throw IOException("Park file section is the wrong size.");
+            }
+
+            size_t dataOffset = 0;
+            for (const SectionRange &range : ranges)
+            {
+                Memory::Copy((uint8 *)s6 + range.Offset, data.data() + dataOffset, range.Length);
+                dataOffset += range.Length;
+            }
+        }
+
+        stream->SetPosition(parkFileStart + parkFileLength);
+    }
+
+    void ReadMeta(IStream * stream, rct_s6_header * header, rct_s6_info * info)
+    {
+        uint64 parkFileStart = stream->GetPosition();
+        auto entries = ReadSectionTable(stream);
+        const ParkFileSectionEntry * entry = FindSection(entries, PARK_FILE_SECTION::META);
+        if (entry == nullptr)
+        {
+            throw IOException("Park file is missing a section.");
+        }
+
+        auto data = ReadSection(stream, parkFileStart, *entry);
+        if (data.size() != sizeof(rct_s6_header) + sizeof(rct_s6_info))
+        {
+            throw IOException("Park file section is the wrong size.");
+        }
+        Memory::Copy(header, (const rct_s6_header *)data.data(), sizeof(rct_s6_header));
+        Memory::Copy(info, (const rct_s6_info *)(data.data() + sizeof(rct_s6_header)), sizeof(rct_s6_info));
+    }
+}
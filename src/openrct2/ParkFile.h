@@ -0,0 +1,100 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <vector>
+#include "common.h"
+
+extern "C"
+{
+    #include "scenario/scenario.h"
+}
+
+interface IStream;
+
+namespace PARK_FILE_SECTION
+{
+    constexpr uint32 META           = 0;    // Header and scenario info
+    constexpr uint32 OBJECTS        = 1;    // Object list
+    constexpr uint32 PARK           = 2;    // Everything not in another section
+    constexpr uint32 MAP            = 3;    // Map elements
+    constexpr uint32 SPRITES        = 4;    // Sprites and sprite lists
+    constexpr uint32 RIDES          = 5;    // Rides
+    constexpr uint32 PACKED_OBJECTS = 6;    // Packed objects in the SV6 chunk format
+    constexpr uint32 COUNT          = 7;
+
+    constexpr uint32 MASK_ALL       = (1 << COUNT) - 1;
+}
+
+namespace PARK_FILE_COMPRESSION
+{
+    constexpr uint32 NONE   = 0;
+    constexpr uint32 ZLIB   = 1;
+    constexpr uint32 ZSTD   = 2;    // Reserved
+}
+
+#pragma pack(push, 1)
+struct ParkFileHeader
+{
+    uint32 Magic;
+    uint16 Version;
+    uint16 NumSections;
+};
+assert_struct_size(ParkFileHeader, 8);
+
+struct ParkFileSectionEntry
+{
+    uint32 Id;
+    uint32 Compression;
+    uint64 Offset;              // Relative to the start of the park file
+    uint64 CompressedLength;
+    uint64 Length;
+    uint32 Crc32;               // Of the compressed data
+};
+assert_struct_size(ParkFileSectionEntry, 36);
+#pragma pack(pop)
+
+/**
+ * An OpenRCT2 park file. The same data as an SV6 / SC6 but split into independently compressed
+ * sections listed in a table at the start of the file. This allows the file to be written quickly
+ * and allows readers that are only interested in part of the park, such as the scenario index,
+ * to skip the rest.
+ */
+namespace ParkFile
+{
+    constexpr uint32 MAGIC = 0x4B52504F; // OPRK
+    constexpr uint16 VERSION = 1;
+
+    /**
+     * Checks whether the stream is positioned at the start of a park file without moving it.
+     */
+    bool IsParkFile(IStream * stream);
+
+    void Write(IStream * stream, const rct_s6_data * s6, const void * packedObjects, size_t packedObjectsLength);
+
+    /**
+     * Reads the sections in sectionMask from the park file at the current position into s6. The
+     * packed objects are read into packedObjects if requested. Leaves the stream positioned after
+     * the park file.
+     */
+    void Read(IStream * stream, rct_s6_data * s6, uint32 sectionMask, std::vector<uint8> * packedObjects = nullptr);
+
+    /**
+     * Reads only the header and scenario info of the park file at the current position.
+     */
+    void ReadMeta(IStream * stream, rct_s6_header * header, rct_s6_info * info);
+}
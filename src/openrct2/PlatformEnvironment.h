@@ -53,6 +53,7 @@ enum class PATHID
     CONFIG_KEYBOARD,    // Keyboard shortcuts. (hotkeys.cfg)
     CACHE_OBJECTS,      // Object repository cache (objects.idx).
     CACHE_TRACKS,       // Track repository cache (tracks.idx).
+    CACHE_SCENARIOS,    // Scenario repository cache (scenarios.idx).
     NETWORK_GROUPS,     // Server groups with permissions (groups.json).
     NETWORK_SERVERS,    // Saved servers (servers.cfg).
     NETWORK_USERS,      // Users and their groups (users.json).
@@ -21,13 +21,23 @@ extern "C"
 
 #include "CommandLine.hpp"
 
+static bool _threaded = false;
+
+static const CommandLineOptionDefinition ScreenshotOptions[]
+{
+    { CMDLINE_TYPE_SWITCH, &_threaded, NAC, "threaded", "compress the image on a separate thread while rendering" },
+    OptionTableEnd
+};
+
 static exitcode_t HandleScreenshot(CommandLineArgEnumerator *argEnumerator);
+static exitcode_t HandleBenchmark(CommandLineArgEnumerator *argEnumerator);
 
 const CommandLineCommand CommandLine::ScreenshotCommands[]
 {
     // Main commands
-    DefineCommand("", "<file> <output_image> <width> <height> [<x> <y> <zoom> <rotation>]", nullptr, HandleScreenshot),
-    DefineCommand("", "<file> <output_image> giant <zoom> <rotation>",                      nullptr, HandleScreenshot),
+    DefineCommand("", "<file> <output_image> <width> <height> [<x> <y> <zoom> <rotation>]", ScreenshotOptions, HandleScreenshot),
+    DefineCommand("", "<file> <output_image> giant <zoom> <rotation>",                      ScreenshotOptions, HandleScreenshot),
+    DefineCommand("benchmark", "<file> [<iterations>]",                                     nullptr,           HandleBenchmark),
     CommandTableEnd
 };
 
@@ -35,7 +45,29 @@ static exitcode_t HandleScreenshot(CommandLineArgEnumerator *argEnumerator)
 {
     const char * * argv = (const char * *)argEnumerator->GetArguments() + argEnumerator->GetIndex();
     sint32 argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
-    sint32 result = cmdline_for_screenshot(argv, argc);
+
+    // Options are always passed after the positional arguments
+    for (sint32 i = 0; i < argc; i++)
+    {
+        if (argv[i][0] == '-')
+        {
+            argc = i;
+            break;
+        }
+    }
+
+    sint32 result = cmdline_for_screenshot(argv, argc, _threaded);
+    if (result < 0) {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+static exitcode_t HandleBenchmark(CommandLineArgEnumerator *argEnumerator)
+{
+    const char * * argv = (const char * *)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    sint32 argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    sint32 result = cmdline_for_render_benchmark(argv, argc);
     if (result < 0) {
         return EXITCODE_FAIL;
     }
@@ -148,6 +148,8 @@ namespace Config
             model->measurement_format = reader->GetEnum<sint32>("measurement_format", MEASUREMENT_FORMAT_METRIC, Enum_MeasurementFormat);
             model->play_intro = reader->GetBoolean("play_intro", false);
             model->save_plugin_data = reader->GetBoolean("save_plugin_data", true);
+            model->save_native_format = reader->GetBoolean("save_native_format", false);
+            model->watch_directories = reader->GetBoolean("watch_directories", false);
             model->debugging_tools = reader->GetBoolean("debugging_tools", false);
             model->show_height_as_units = reader->GetBoolean("show_height_as_units", false);
             model->temperature_format = reader->GetEnum<sint32>("temperature_format", TEMPERATURE_FORMAT_C, Enum_Temperature);
@@ -221,6 +223,8 @@ namespace Config
         writer->WriteEnum<sint32>("measurement_format", model->measurement_format, Enum_MeasurementFormat);
         writer->WriteBoolean("play_intro", model->play_intro);
         writer->WriteBoolean("save_plugin_data", model->save_plugin_data);
+        writer->WriteBoolean("save_native_format", model->save_native_format);
+        writer->WriteBoolean("watch_directories", model->watch_directories);
         writer->WriteBoolean("debugging_tools", model->debugging_tools);
         writer->WriteBoolean("show_height_as_units", model->show_height_as_units);
         writer->WriteEnum<sint32>("temperature_format", model->temperature_format, Enum_Temperature);
@@ -461,6 +465,7 @@ namespace Config
             model->height_small = reader->GetSint32("height_small", false);
             model->height_medium = reader->GetSint32("height_medium", false);
             model->height_big = reader->GetSint32("height_big", false);
+            model->cache_size = reader->GetSint32("cache_size", 8192);
         }
     }
 
@@ -480,6 +485,7 @@ namespace Config
         writer->WriteSint32("height_small", model->height_small);
         writer->WriteSint32("height_medium", model->height_medium);
         writer->WriteSint32("height_big", model->height_big);
+        writer->WriteSint32("cache_size", model->cache_size);
     }
 
     static bool SetDefaults()
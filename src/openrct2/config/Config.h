@@ -71,6 +71,8 @@ typedef struct GeneralConfiguration
     sint32      window_snap_proximity;
     bool        allow_loading_with_incorrect_checksum;
     bool        save_plugin_data;
+    bool        save_native_format;
+    bool        watch_directories;
     bool        test_unfinished_tracks;
     bool        no_test_crashes;
     bool        debugging_tools;
@@ -185,6 +187,7 @@ typedef struct FontConfiguration
     sint32      height_small;
     sint32      height_medium;
     sint32      height_big;
+    sint32      cache_size;
 } FontConfiguration;
 
 enum SORT
@@ -33,6 +33,8 @@
     }
 #endif
 
+#include <algorithm>
+#include <cstring>
 #include <stack>
 #include <string>
 #include <vector>
@@ -57,7 +59,8 @@ struct DirectoryChild
     DIRECTORY_CHILD_TYPE Type;
     std::string Name;
 
-    // Files only
+    // Files only, HasFileInfo is false if Size and LastModified have not been read yet
+    bool   HasFileInfo  = false;
     uint64 Size         = 0;
     uint64 LastModified = 0;
 };
@@ -85,8 +88,10 @@ private:
     std::stack<DirectoryState>  _directoryStack;
 
     // Current
-    FileInfo    * _currentFileInfo;
-    utf8        * _currentPath;
+    FileInfo                * _currentFileInfo;
+    utf8                    * _currentPath;
+    const DirectoryChild    * _currentChild;
+    mutable bool              _currentFileInfoRead;
 
 public:
     FileScannerBase(const std::string &pattern, bool recurse)
@@ -109,6 +114,20 @@ public:
 
     const FileInfo * GetFileInfo() const override
     {
+        // Only read the size and modification time if the caller needs them
+        if (!_currentFileInfoRead && _currentChild != nullptr)
+        {
+            _currentFileInfoRead = true;
+            if (_currentChild->HasFileInfo)
+            {
+                _currentFileInfo->Size = _currentChild->Size;
+                _currentFileInfo->LastModified = _currentChild->LastModified;
+            }
+            else
+            {
+                ReadFileInfo(_currentPath, &_currentFileInfo->Size, &_currentFileInfo->LastModified);
+            }
+        }
         return _currentFileInfo;
     }
 
@@ -128,10 +147,13 @@ public:
         _started = false;
         _directoryStack = std::stack<DirectoryState>();
         _currentPath[0] = 0;
+        _currentChild = nullptr;
+        _currentFileInfoRead = false;
     }
 
     bool Next() override
     {
+        _currentChild = nullptr;
         if (!_started)
         {
             _started = true;
@@ -163,8 +185,10 @@ public:
                     Path::Append(_currentPath, MAX_PATH, child->Name.c_str());
 
                     _currentFileInfo->Name = child->Name.c_str();
-                    _currentFileInfo->Size = child->Size;
-                    _currentFileInfo->LastModified = child->LastModified;
+                    _currentFileInfo->Size = 0;
+                    _currentFileInfo->LastModified = 0;
+                    _currentChild = child;
+                    _currentFileInfoRead = false;
                     return true;
                 }
             }
@@ -225,6 +249,15 @@ private:
 protected:
     virtual void GetDirectoryChildren(std::vector<DirectoryChild> &children, const std::string &path) abstract;
 
+    /**
+     * Reads the size and modification time of a file that was listed without them.
+     */
+    virtual void ReadFileInfo(const utf8 * path, uint64 * outSize, uint64 * outLastModified) const
+    {
+        *outSize = 0;
+        *outLastModified = 0;
+    }
+
 };
 
 #ifdef __WINDOWS__
@@ -279,6 +312,7 @@ private:
         else
         {
             result.Type = DIRECTORY_CHILD_TYPE::DC_FILE;
+            result.HasFileInfo = true;
             result.Size = ((uint64)child->nFileSizeHigh << 32ULL) | (uint64)child->nFileSizeLow;
             result.LastModified = ((uint64)child->ftLastWriteTime.dwHighDateTime << 32ULL) | (uint64)child->ftLastWriteTime.dwLowDateTime;
         }
@@ -301,59 +335,78 @@ public:
 protected:
     void GetDirectoryChildren(std::vector<DirectoryChild> &children, const std::string &path) override
     {
-        struct dirent * * namelist;
-        sint32 count = scandir(path.c_str(), &namelist, FilterFunc, alphasort);
-        if (count > 0)
+        DIR * dir = opendir(path.c_str());
+        if (dir == nullptr)
         {
-            for (sint32 i = 0; i < count; i++)
+            return;
+        }
+
+        // The type comes from the directory entry on most file systems, so files are only stat'd
+        // when their size or modification time is asked for
+        const struct dirent * node;
+        while ((node = readdir(dir)) != nullptr)
+        {
+            if (!String::Equals(node->d_name, ".") &&
+                !String::Equals(node->d_name, ".."))
             {
-                const struct dirent * node = namelist[i];
-                if (!String::Equals(node->d_name, ".") &&
-                    !String::Equals(node->d_name, ".."))
-                {
-                    DirectoryChild child = CreateChild(path.c_str(), node);
-                    children.push_back(child);
-                }
-                free(namelist[i]);
+                DirectoryChild child = CreateChild(path.c_str(), node);
+                children.push_back(child);
             }
-            free(namelist);
         }
+        closedir(dir);
+
+        // Keep the same order as scandir with alphasort
+        std::sort(children.begin(), children.end(), [](const DirectoryChild &a, const DirectoryChild &b) -> bool
+        {
+            return strcoll(a.Name.c_str(), b.Name.c_str()) < 0;
+        });
     }
 
-private:
-    static sint32 FilterFunc(const struct dirent * d)
+    void ReadFileInfo(const utf8 * path, uint64 * outSize, uint64 * outLastModified) const override
     {
-        return 1;
+        struct stat statInfo;
+        if (stat(path, &statInfo) != -1)
+        {
+            *outSize = statInfo.st_size;
+            *outLastModified = statInfo.st_mtime;
+        }
+        else
+        {
+            *outSize = 0;
+            *outLastModified = 0;
+        }
     }
 
+private:
     static DirectoryChild CreateChild(const utf8 * directory, const struct dirent * node)
     {
         DirectoryChild result;
         result.Name = std::string(node->d_name);
-        if (node->d_type & DT_DIR)
-        {
-            result.Type = DIRECTORY_CHILD_TYPE::DC_DIRECTORY;
-        }
-        else
-        {
-            result.Type = DIRECTORY_CHILD_TYPE::DC_FILE;
 
-            // Get the full path of the file
-            size_t pathSize = String::SizeOf(directory) + 1 + String::SizeOf(node->d_name) + 1;
-            utf8 * path = Memory::Allocate<utf8>(pathSize);
-            String::Set(path, pathSize, directory);
-            Path::Append(path, pathSize, node->d_name);
+        bool isDirectory = node->d_type == DT_DIR;
+        if (node->d_type == DT_UNKNOWN)
+        {
+            // Not all file systems fill in d_type
+            utf8 path[MAX_PATH];
+            String::Set(path, sizeof(path), directory);
+            Path::Append(path, sizeof(path), node->d_name);
 
             struct stat statInfo;
-            sint32 statRes = stat(path, &statInfo);
-            if (statRes != -1)
+            if (stat(path, &statInfo) != -1)
             {
-                result.Size = statInfo.st_size;
-                result.LastModified = statInfo.st_mtime;
+                isDirectory = S_ISDIR(statInfo.st_mode);
+                if (!isDirectory)
+                {
+                    result.HasFileInfo = true;
+                    result.Size = statInfo.st_size;
+                    result.LastModified = statInfo.st_mtime;
+                }
             }
-
-            Memory::Free(path);
         }
+
+        result.Type = isDirectory ?
+            DIRECTORY_CHILD_TYPE::DC_DIRECTORY :
+            DIRECTORY_CHILD_TYPE::DC_FILE;
         return result;
     }
 };
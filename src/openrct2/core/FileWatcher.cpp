@@ -0,0 +1,179 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "../common.h"
+
+#ifdef __linux__
+    #include <dirent.h>
+    #include <errno.h>
+    #include <sys/inotify.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "FileWatcher.h"
+#include "Path.hpp"
+#include "String.hpp"
+
+FileWatcher::FileWatcher(const std::vector<std::string> &directories)
+    : _directories(directories)
+{
+    Start();
+}
+
+FileWatcher::~FileWatcher()
+{
+    Stop();
+}
+
+bool FileWatcher::HasChanged(std::unique_ptr<FileWatcher> &watcher, const std::vector<std::string> &directories, bool watch)
+{
+    if (!watch)
+    {
+        watcher = nullptr;
+        return true;
+    }
+    if (watcher == nullptr || watcher->_directories != directories)
+    {
+        watcher = std::unique_ptr<FileWatcher>(new FileWatcher(directories));
+        return true;
+    }
+    return watcher->HasChanged();
+}
+
+#ifdef __linux__
+
+bool FileWatcher::HasChanged()
+{
+    ReadEvents();
+    if (!_changed)
+    {
+        return false;
+    }
+
+    // Watch again from scratch so that new sub directories are included
+    Stop();
+    _changed = false;
+    Start();
+    return true;
+}
+
+void FileWatcher::Start()
+{
+    _fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_fd == -1)
+    {
+        log_warning("Unable to watch directories for changes, errno = %d", errno);
+        _changed = true;
+        return;
+    }
+
+    for (const auto &directory : _directories)
+    {
+        AddWatches(directory);
+    }
+}
+
+void FileWatcher::Stop()
+{
+    if (_fd != -1)
+    {
+        close(_fd);
+        _fd = -1;
+    }
+}
+
+void FileWatcher::AddWatches(const std::string &directory)
+{
+    constexpr uint32 mask = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB |
+                            IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+    if (inotify_add_watch(_fd, directory.c_str(), mask) == -1)
+    {
+        // Missing directories are fine, but anything else means changes could be missed
+        if (errno != ENOENT && errno != ENOTDIR)
+        {
+            _changed = true;
+        }
+        return;
+    }
+
+    DIR * dir = opendir(directory.c_str());
+    if (dir == nullptr)
+    {
+        return;
+    }
+
+    const struct dirent * node;
+    while ((node = readdir(dir)) != nullptr)
+    {
+        if (String::Equals(node->d_name, ".") ||
+            String::Equals(node->d_name, ".."))
+        {
+            continue;
+        }
+
+        std::string path = Path::Combine(directory, node->d_name);
+        bool isDirectory = node->d_type == DT_DIR;
+        if (node->d_type == DT_UNKNOWN)
+        {
+            struct stat statInfo;
+            isDirectory = stat(path.c_str(), &statInfo) != -1 && S_ISDIR(statInfo.st_mode);
+        }
+        if (isDirectory)
+        {
+            AddWatches(path);
+        }
+    }
+    closedir(dir);
+}
+
+void FileWatcher::ReadEvents()
+{
+    if (_fd == -1)
+    {
+        _changed = true;
+        return;
+    }
+
+    // Any event, including a queue overflow, counts as a change so the contents are not needed
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(_fd, buffer, sizeof(buffer))) > 0)
+    {
+        _changed = true;
+    }
+    if (length == -1 && errno != EAGAIN && errno != EWOULDBLOCK)
+    {
+        _changed = true;
+    }
+}
+
+#else
+
+bool FileWatcher::HasChanged()
+{
+    return true;
+}
+
+void FileWatcher::Start()
+{
+}
+
+void FileWatcher::Stop()
+{
+}
+
+#endif // __linux__
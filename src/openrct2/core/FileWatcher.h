@@ -0,0 +1,62 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../common.h"
+
+/**
+ * Watches directories and all their sub directories for files being added, removed or modified
+ * so that a repository only needs to scan them again after a real change. On platforms without
+ * support every check reports a change.
+ */
+class FileWatcher final
+{
+private:
+    std::vector<std::string>    _directories;
+#ifdef __linux__
+    bool                        _changed = false;
+    sint32                      _fd = -1;
+#endif
+
+public:
+    explicit FileWatcher(const std::vector<std::string> &directories);
+    ~FileWatcher();
+
+    /**
+     * Returns whether anything may have changed in the watched directories since the watcher was
+     * created or since the last time this returned true.
+     */
+    bool HasChanged();
+
+    /**
+     * Returns false only if watch is set and nothing in the directories has changed since the
+     * last call. Creates the watcher on the first call and replaces it if the directories differ,
+     * releases it if watch is not set.
+     */
+    static bool HasChanged(std::unique_ptr<FileWatcher> &watcher, const std::vector<std::string> &directories, bool watch);
+
+private:
+    void Start();
+    void Stop();
+#ifdef __linux__
+    void AddWatches(const std::string &directory);
+    void ReadEvents();
+#endif
+};
@@ -0,0 +1,151 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include "../common.h"
+
+#ifdef __WINDOWS__
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#endif
+
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "File.h"
+#include "IStream.hpp"
+#include "Memory.hpp"
+#include "MemoryMappedFile.h"
+
+extern "C"
+{
+    #include "../localisation/language.h"
+}
+
+MemoryMappedFile::MemoryMappedFile(const std::string &path)
+{
+    if (!Map(path))
+    {
+        // Not supported or failed, fall back to reading the whole file
+        _data = File::ReadAllBytes(path, &_length);
+        _mapped = false;
+    }
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (_mapped)
+    {
+        Unmap();
+    }
+    else
+    {
+        Memory::Free(_data);
+    }
+    _data = nullptr;
+    _length = 0;
+}
+
+#ifdef __WINDOWS__
+
+bool MemoryMappedFile::Map(const std::string &path)
+{
+    wchar_t * wPath = utf8_to_widechar(path.c_str());
+    HANDLE hFile = CreateFileW(wPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    Memory::Free(wPath);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        throw IOException("Unable to open '" + path + "'.");
+    }
+
+    LARGE_INTEGER fileSize;
+    bool result = false;
+    if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0 && (uint64)fileSize.QuadPart <= SIZE_MAX)
+    {
+        // The view keeps the mapping alive after its handle is closed
+        HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (hMapping != nullptr)
+        {
+            void * data = MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0);
+            if (data != nullptr)
+            {
+                _data = data;
+                _length = (size_t)fileSize.QuadPart;
+                _mapped = true;
+                result = true;
+            }
+            CloseHandle(hMapping);
+        }
+    }
+    CloseHandle(hFile);
+    return result;
+}
+
+void MemoryMappedFile::Unmap()
+{
+    UnmapViewOfFile(_data);
+}
+
+#elif defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+
+bool MemoryMappedFile::Map(const std::string &path)
+{
+    sint32 fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw IOException("Unable to open '" + path + "'.");
+    }
+
+    struct stat statInfo;
+    bool result = false;
+    if (fstat(fd, &statInfo) == 0 && statInfo.st_size > 0 && (uint64)statInfo.st_size <= SIZE_MAX)
+    {
+        // The mapping stays valid after the descriptor is closed
+        size_t length = (size_t)statInfo.st_size;
+        void * data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            _data = data;
+            _length = length;
+            _mapped = true;
+            result = true;
+        }
+    }
+    close(fd);
+    return result;
+}
+
+void MemoryMappedFile::Unmap()
+{
+    munmap(_data, _length);
+}
+
+#else
+
+bool MemoryMappedFile::Map(const std::string &path)
+{
+    UNUSED(path);
+    return false;
+}
+
+void MemoryMappedFile::Unmap()
+{
+}
+
+#endif
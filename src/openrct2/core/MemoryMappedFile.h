@@ -0,0 +1,48 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <string>
+#include "../common.h"
+
+/**
+ * Provides the contents of a whole file in memory. Where supported the file is memory mapped so
+ * that only the pages that are actually accessed are read from disk, otherwise the file is read
+ * into a buffer. Changes made to the data are private to the process and never written back.
+ */
+class MemoryMappedFile final
+{
+private:
+    void *  _data   = nullptr;
+    size_t  _length = 0;
+    bool    _mapped = false;
+
+public:
+    explicit MemoryMappedFile(const std::string &path);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile & operator=(const MemoryMappedFile &) = delete;
+
+    void *  GetData() const { return _data; }
+    size_t  GetLength() const { return _length; }
+    bool    IsMapped() const { return _mapped; }
+
+private:
+    bool Map(const std::string &path);
+    void Unmap();
+};
@@ -0,0 +1,78 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <vector>
+#include <SDL_atomic.h>
+#include <SDL_cpuinfo.h>
+#include <SDL_thread.h>
+#include "Math.hpp"
+#include "Parallel.h"
+
+struct ParallelForState
+{
+    const std::function<void(size_t)> * Func;
+    size_t      Count;
+    SDL_atomic_t NextIndex;
+};
+
+static void RunParallelFor(ParallelForState * state)
+{
+    size_t index;
+    while ((index = (size_t)SDL_AtomicAdd(&state->NextIndex, 1)) < state->Count)
+    {
+        (*state->Func)(index);
+    }
+}
+
+namespace Parallel
+{
+    void For(size_t count, const std::function<void(size_t)> &func)
+    {
+        ParallelForState state;
+        state.Func = &func;
+        state.Count = count;
+        SDL_AtomicSet(&state.NextIndex, 0);
+
+        // The calling thread takes part, so only start workers for the remaining CPUs
+        size_t numWorkers = 0;
+        if (count > 1)
+        {
+            numWorkers = Math::Min((size_t)Math::Max(SDL_GetCPUCount() - 1, 0), count - 1);
+        }
+
+        std::vector<SDL_Thread *> workers;
+        for (size_t i = 0; i < numWorkers; i++)
+        {
+            SDL_Thread * thread = SDL_CreateThread([](void * ptr) -> sint32
+            {
+                RunParallelFor((ParallelForState *)ptr);
+                return 0;
+            }, "parallel_for", &state);
+            if (thread == nullptr)
+            {
+                break;
+            }
+            workers.push_back(thread);
+        }
+
+        RunParallelFor(&state);
+
+        for (SDL_Thread * thread : workers)
+        {
+            SDL_WaitThread(thread, nullptr);
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <functional>
+#include "../common.h"
+
+namespace Parallel
+{
+    /**
+     * Calls func for each index in [0, count) using the calling thread and a worker thread for
+     * each additional CPU. Returns once every call has completed. func must be safe to call
+     * concurrently and the order of the calls is undefined.
+     */
+    void For(size_t count, const std::function<void(size_t)> &func);
+}
@@ -40,6 +40,7 @@ enum DRAWING_ENGINE_FLAGS
 
 #ifdef __cplusplus
 
+struct dirty_region_stats;
 struct rct_drawpixelinfo;
 interface IDrawingContext;
 
@@ -64,6 +65,8 @@ interface IDrawingEngine
     virtual DRAWING_ENGINE_FLAGS GetFlags() abstract;
 
     virtual void InvalidateImage(uint32 image) abstract;
+
+    virtual bool GetDirtyRegionStats(dirty_region_stats * stats) abstract;
 };
 
 namespace DrawingEngineFactory
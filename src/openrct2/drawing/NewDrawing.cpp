@@ -191,6 +191,7 @@ extern "C"
 
     void drawing_engine_invalidate_image(uint32 image)
     {
+        gfx_invalidate_remapped_sprite(image);
         if (_drawingEngine != nullptr)
         {
             _drawingEngine->InvalidateImage(image);
@@ -205,6 +206,16 @@ extern "C"
         }
     }
 
+    bool drawing_engine_get_dirty_region_stats(dirty_region_stats * stats)
+    {
+        bool result = false;
+        if (_drawingEngine != nullptr)
+        {
+            result = _drawingEngine->GetDirtyRegionStats(stats);
+        }
+        return result;
+    }
+
     void gfx_set_dirty_blocks(sint16 left, sint16 top, sint16 right, sint16 bottom)
     {
         if (_drawingEngine != nullptr)
@@ -41,6 +41,7 @@ rct_drawpixelinfo * drawing_engine_get_dpi();
 bool drawing_engine_has_dirty_optimisations();
 void drawing_engine_invalidate_image(uint32 image);
 void drawing_engine_set_fps_uncapped(bool uncapped);
+bool drawing_engine_get_dirty_region_stats(dirty_region_stats * stats);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,314 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include "../core/Math.hpp"
+#include "SpriteCache.h"
+
+/**
+ * Returns the number of bytes used by an RLE sprite, including its table of line offsets.
+ */
+static size_t GetRLEDataSize(const rct_g1_element * element)
+{
+    const uint8 * data = element->offset;
+    size_t size = element->height * sizeof(uint16);
+    for (sint32 y = 0; y < element->height; y++)
+    {
+        const uint8 * source = data + ((const uint16 *)data)[y];
+        uint8 lastDataLine = 0;
+        while (!lastDataLine)
+        {
+            uint8 numPixels = source[0];
+            lastDataLine = numPixels & 0x80;
+            source += 2 + (numPixels & 0x7F);
+        }
+        size = Math::Max(size, (size_t)(source - data));
+    }
+    return size;
+}
+
+/**
+ * Applies the palette to the pixels of each run, leaving the run headers and line offsets as
+ * they are. Lines may share runs so the source is always read from the original data.
+ */
+static void RemapRLEData(const rct_g1_element * element, uint8 * dst, const uint8 * palette)
+{
+    const uint8 * data = element->offset;
+    for (sint32 y = 0; y < element->height; y++)
+    {
+        size_t offset = ((const uint16 *)data)[y];
+        uint8 lastDataLine = 0;
+        while (!lastDataLine)
+        {
+            uint8 numPixels = data[offset];
+            lastDataLine = numPixels & 0x80;
+            numPixels &= 0x7F;
+            offset += 2;
+            for (uint8 i = 0; i < numPixels; i++, offset++)
+            {
+                dst[offset] = palette[data[offset]];
+            }
+        }
+    }
+}
+
+/**
+ * Builds the rows of a zoomed RLE sprite, see SpriteCache::GetZoomed. The pixels of each run are
+ * picked exactly as DrawRLESprite2 in drawing_fast.cpp does for a sprite that is not clipped on
+ * the left.
+ */
+static void ZoomRLEData(const rct_g1_element * element, std::vector<uint8> &dst, sint32 zoomLevel, sint32 rowPhase)
+{
+    const uint8 * data = element->offset;
+    sint32 zoomAmount = 1 << zoomLevel;
+    sint32 zoomMask = zoomAmount - 1;
+    sint32 numRows = (element->height - rowPhase + zoomMask) >> zoomLevel;
+
+    dst.assign(numRows * sizeof(uint16), 0);
+    std::vector<uint8> columns;
+    std::vector<uint8> pixels;
+    for (sint32 row = 0; row < numRows; row++)
+    {
+        columns.clear();
+        pixels.clear();
+
+        const uint8 * source = data + ((const uint16 *)data)[rowPhase + (row << zoomLevel)];
+        uint8 lastDataLine = 0;
+        while (!lastDataLine)
+        {
+            sint32 numPixels = source[0];
+            sint32 xStart = source[1];
+            const uint8 * runPixels = source + 2;
+            lastDataLine = numPixels & 0x80;
+            numPixels &= 0x7F;
+            source = runPixels + numPixels;
+
+            sint32 sourceOffset = 0;
+            sint32 xDiff = xStart & zoomMask;
+            if (xDiff > 0)
+            {
+                numPixels -= xDiff;
+                xStart += zoomMask;
+                sourceOffset = xStart & zoomMask;
+            }
+            numPixels = Math::Min<sint32>(numPixels, element->width - xStart);
+
+            sint32 column = xStart >> zoomLevel;
+            for (; numPixels > 0; numPixels -= zoomAmount, sourceOffset += zoomAmount, column++)
+            {
+                columns.push_back((uint8)column);
+                pixels.push_back(runPixels[sourceOffset]);
+            }
+        }
+
+        ((uint16 *)dst.data())[row] = (uint16)dst.size();
+        if (columns.empty())
+        {
+            dst.push_back(0x80);
+            dst.push_back(0);
+            continue;
+        }
+
+        // Join adjacent columns into runs
+        size_t runStart = 0;
+        while (runStart < columns.size())
+        {
+            size_t runEnd = runStart + 1;
+            while (runEnd < columns.size() && columns[runEnd] == columns[runEnd - 1] + 1 && runEnd - runStart < 0x7F)
+            {
+                runEnd++;
+            }
+            uint8 lastRun = runEnd == columns.size() ? 0x80 : 0;
+            dst.push_back((uint8)(runEnd - runStart) | lastRun);
+            dst.push_back(columns[runStart]);
+            dst.insert(dst.end(), pixels.begin() + runStart, pixels.begin() + runEnd);
+            runStart = runEnd;
+        }
+    }
+}
+
+SpriteCache::SpriteCache(size_t budget)
+    : _budget(budget)
+{
+}
+
+const rct_g1_element * SpriteCache::GetRemapped(uint32 imageIndex, const rct_g1_element * source, uint32 paletteKey, const uint8 * palette)
+{
+    uint64 key = ((uint64)paletteKey << 32) | imageIndex;
+    const rct_g1_element * result = Find(key, source);
+    if (result != nullptr)
+    {
+        return result;
+    }
+
+    if (source->offset == nullptr || (source->flags & G1_FLAG_1) || source->width <= 0 || source->height <= 0)
+    {
+        return nullptr;
+    }
+
+    Entry entry;
+    entry.Key = key;
+    entry.ImageIndex = imageIndex;
+    entry.SourceOffset = source->offset;
+    entry.Element = *source;
+    if (source->flags & G1_FLAG_RLE_COMPRESSION)
+    {
+        size_t size = GetRLEDataSize(source);
+        entry.Data.assign(source->offset, source->offset + size);
+        RemapRLEData(source, entry.Data.data(), palette);
+    }
+    else
+    {
+        size_t size = (size_t)source->width * source->height;
+        entry.Data.resize(size);
+        for (size_t i = 0; i < size; i++)
+        {
+            entry.Data[i] = palette[source->offset[i]];
+        }
+
+        // Remapped bitmaps never draw pixels that map to 0, which a plain bitmap only does with this flag
+        entry.Element.flags |= G1_FLAG_BMP;
+    }
+    return Add(std::move(entry));
+}
+
+const rct_g1_element * SpriteCache::GetZoomed(uint32 imageIndex, const rct_g1_element * source, uint32 paletteKey, sint32 zoomLevel, sint32 rowPhase)
+{
+    // Palette keys only use the lower 27 bits, see gfx_draw_sprite_get_palette_key
+    uint64 key = ((uint64)paletteKey << 32) | imageIndex | ((uint64)zoomLevel << 59) | ((uint64)rowPhase << 61);
+    const rct_g1_element * result = Find(key, source);
+    if (result != nullptr)
+    {
+        return result;
+    }
+
+    if (source->offset == nullptr || !(source->flags & G1_FLAG_RLE_COMPRESSION) || source->width <= 0 || source->height <= rowPhase)
+    {
+        return nullptr;
+    }
+
+    Entry entry;
+    entry.Key = key;
+    entry.ImageIndex = imageIndex;
+    entry.SourceOffset = source->offset;
+    entry.Element = *source;
+    entry.Element.width = (source->width + (1 << zoomLevel) - 1) >> zoomLevel;
+    entry.Element.height = (source->height - rowPhase + (1 << zoomLevel) - 1) >> zoomLevel;
+    entry.Element.x_offset = 0;
+    entry.Element.y_offset = 0;
+    entry.Element.flags = G1_FLAG_RLE_COMPRESSION;
+    ZoomRLEData(source, entry.Data, zoomLevel, rowPhase);
+    return Add(std::move(entry));
+}
+
+const rct_g1_element * SpriteCache::Find(uint64 key, const rct_g1_element * source)
+{
+    auto mapIt = _entryMap.find(key);
+    if (mapIt == _entryMap.end())
+    {
+        return nullptr;
+    }
+
+    EntryList::iterator it = mapIt->second;
+    if (it->SourceOffset != source->offset)
+    {
+        // The image has been replaced without being invalidated
+        Remove(it);
+        return nullptr;
+    }
+
+    // Move to the front of the list
+    if (it != _entries.begin())
+    {
+        _entries.splice(_entries.begin(), _entries, it);
+    }
+    return &it->Element;
+}
+
+void SpriteCache::Invalidate(uint32 imageIndex)
+{
+    auto keysIt = _imageEntryKeys.find(imageIndex);
+    if (keysIt == _imageEntryKeys.end())
+    {
+        return;
+    }
+
+    // Remove erases from the list being iterated
+    std::vector<uint64> keys = std::move(keysIt->second);
+    _imageEntryKeys.erase(keysIt);
+    for (uint64 key : keys)
+    {
+        auto mapIt = _entryMap.find(key);
+        if (mapIt != _entryMap.end())
+        {
+            Remove(mapIt->second);
+        }
+    }
+}
+
+void SpriteCache::Clear()
+{
+    _entries.clear();
+    _entryMap.clear();
+    _imageEntryKeys.clear();
+    _size = 0;
+}
+
+const rct_g1_element * SpriteCache::Add(Entry &&entry)
+{
+    size_t entrySize = entry.Data.size() + EntryOverhead;
+    if (entrySize > _budget)
+    {
+        return nullptr;
+    }
+
+    while (!_entries.empty() && _size + entrySize > _budget)
+    {
+        Remove(std::prev(_entries.end()));
+    }
+
+    _entries.push_front(std::move(entry));
+    Entry &added = _entries.front();
+    _entryMap[added.Key] = _entries.begin();
+    _imageEntryKeys[added.ImageIndex].push_back(added.Key);
+    _size += entrySize;
+
+    added.Element.offset = added.Data.data();
+    return &added.Element;
+}
+
+void SpriteCache::Remove(EntryList::iterator it)
+{
+    _size -= it->Data.size() + EntryOverhead;
+    _entryMap.erase(it->Key);
+
+    auto keysIt = _imageEntryKeys.find(it->ImageIndex);
+    if (keysIt != _imageEntryKeys.end())
+    {
+        std::vector<uint64> &keys = keysIt->second;
+        auto keyIt = std::find(keys.begin(), keys.end(), it->Key);
+        if (keyIt != keys.end())
+        {
+            *keyIt = keys.back();
+            keys.pop_back();
+        }
+        if (keys.empty())
+        {
+            _imageEntryKeys.erase(keysIt);
+        }
+    }
+    _entries.erase(it);
+}
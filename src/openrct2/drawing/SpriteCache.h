@@ -0,0 +1,90 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "../common.h"
+
+extern "C"
+{
+    #include "drawing.h"
+}
+
+/**
+ * Keeps variants of sprites that are expensive to draw directly:
+ *  - remapped: a copy with a remap palette already applied, so sprites drawn with the same colours
+ *    over and over can be copied to the screen like plain sprites.
+ *  - zoomed: an RLE sprite with the pixels already picked that a zoomed out viewport would sample,
+ *    so drawing costs as much as the pixels drawn rather than the size of the full sprite.
+ * Entries are keyed by image and variant and the least recently used ones are evicted once the
+ * budget is exceeded.
+ */
+class SpriteCache final
+{
+private:
+    struct Entry
+    {
+        uint64              Key;
+        uint32              ImageIndex;
+        const uint8 *       SourceOffset;
+        rct_g1_element      Element;
+        std::vector<uint8>  Data;
+    };
+
+    typedef std::list<Entry> EntryList;
+
+    static constexpr size_t EntryOverhead = sizeof(Entry) + 64;
+
+    size_t                                          _budget;
+    size_t                                          _size = 0;
+    EntryList                                       _entries;   // Most recently used first
+    std::unordered_map<uint64, EntryList::iterator> _entryMap;
+    std::unordered_map<uint32, std::vector<uint64>> _imageEntryKeys;    // Keys of the entries of each image
+
+public:
+    static constexpr size_t DefaultBudget = 16 * 1024 * 1024;
+
+    explicit SpriteCache(size_t budget = DefaultBudget);
+
+    /**
+     * Returns the element to draw in place of source with palette applied, or nullptr if the
+     * sprite can not be remapped ahead of drawing. paletteKey must uniquely identify the contents
+     * of palette.
+     */
+    const rct_g1_element * GetRemapped(uint32 imageIndex, const rct_g1_element * source, uint32 paletteKey, const uint8 * palette);
+
+    /**
+     * Returns an RLE sprite made of every (1 << zoomLevel)th row of source starting at rowPhase, with
+     * the pixels of each row that gfx_rle_sprite_to_buffer would sample at that zoom level. It is
+     * drawn at zoom level 0 with all coordinates divided by the zoom. source may be a remapped
+     * variant of the image, in which case paletteKey must be the one it was remapped with, else 0.
+     */
+    const rct_g1_element * GetZoomed(uint32 imageIndex, const rct_g1_element * source, uint32 paletteKey, sint32 zoomLevel, sint32 rowPhase);
+
+    /**
+     * Removes all entries of the given image, must be called whenever the image data changes.
+     */
+    void Invalidate(uint32 imageIndex);
+    void Clear();
+
+private:
+    const rct_g1_element * Find(uint64 key, const rct_g1_element * source);
+    const rct_g1_element * Add(Entry &&entry);
+    void Remove(EntryList::iterator it);
+};
@@ -58,6 +58,23 @@ typedef struct rct_drawpixelinfo {
 assert_struct_size(rct_drawpixelinfo, 0x10);
 #endif
 
+// Measures how much of the screen was redrawn in a frame by engines with dirty optimisations
+typedef struct dirty_region_stats {
+	uint32 invalidated_area;	// Sum of the invalidated areas as requested, before merging
+	uint32 merged_area;			// Pixels covered by the invalidated regions once merged
+	uint32 redrawn_area;		// Pixels redrawn, including gaps merged in between invalidations
+	uint32 redrawn_regions;		// Number of separate redraw passes
+} dirty_region_stats;
+
+typedef struct ttf_cache_stats {
+	uint32 count;		// Number of cached strings
+	uint32 size;		// Bytes used by cached strings
+	uint32 budget;		// Bytes the cache may use before evicting
+	uint32 hits;
+	uint32 misses;
+	uint32 evictions;
+} ttf_cache_stats;
+
 // Size: 0x10
 typedef struct rct_g1_element_32bit {
 	uint32 offset;                  // 0x00 note: uint32 always!
@@ -317,6 +334,7 @@ void gfx_unload_g1();
 void gfx_unload_g2();
 void gfx_unload_csg();
 rct_g1_element* gfx_get_g1_element(sint32 image_id);
+void gfx_invalidate_remapped_sprite(uint32 image_id);
 uint32 gfx_object_allocate_images(const rct_g1_element * images, uint32 count);
 void gfx_object_free_images(uint32 baseImageId, uint32 count);
 void gfx_object_check_all_images_freed();
@@ -358,6 +376,7 @@ void shorten_path(utf8 *buffer, size_t bufferSize, const utf8 *path, sint32 avai
 #ifndef NO_TTF
 SDL_Surface *ttf_surface_cache_get_or_add(TTF_Font *font, const utf8 *text);
 TTFFontDescriptor *ttf_get_font_from_sprite_base(uint16 spriteBase);
+void ttf_get_cache_stats(ttf_cache_stats *surfaceStats, ttf_cache_stats *widthStats);
 #endif // NO_TTF
 
 bool ttf_initialise();
@@ -365,6 +384,7 @@ void ttf_dispose();
 
 // scrolling text
 void scrolling_text_initialise_bitmaps();
+void scrolling_text_dispose();
 sint32 scrolling_text_setup(rct_string_id stringId, uint16 scroll, uint16 scrollingMode);
 
 void rct2_draw(rct_drawpixelinfo *dpi);
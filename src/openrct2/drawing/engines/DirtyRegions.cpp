@@ -0,0 +1,176 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#include <algorithm>
+#include "../../core/Math.hpp"
+#include "DirtyRegions.h"
+
+static DirtyRect GetUnion(const DirtyRect &a, const DirtyRect &b)
+{
+    return { Math::Min(a.Left, b.Left),
+             Math::Min(a.Top, b.Top),
+             Math::Max(a.Right, b.Right),
+             Math::Max(a.Bottom, b.Bottom) };
+}
+
+static bool Contains(const DirtyRect &a, const DirtyRect &b)
+{
+    return a.Left <= b.Left && a.Top <= b.Top &&
+           a.Right >= b.Right && a.Bottom >= b.Bottom;
+}
+
+static sint32 GetIntersectionArea(const DirtyRect &a, const DirtyRect &b)
+{
+    sint32 width = Math::Min(a.Right, b.Right) - Math::Max(a.Left, b.Left);
+    sint32 height = Math::Min(a.Bottom, b.Bottom) - Math::Max(a.Top, b.Top);
+    if (width <= 0 || height <= 0)
+    {
+        return 0;
+    }
+    return width * height;
+}
+
+/**
+ * Returns the number of pixels that would be redrawn needlessly if a and b were replaced by
+ * their union.
+ */
+static sint32 GetMergeCost(const DirtyRect &a, const DirtyRect &b)
+{
+    return GetUnion(a, b).GetArea() - (a.GetArea() + b.GetArea() - GetIntersectionArea(a, b));
+}
+
+void DirtyRegions::SetSize(sint32 width, sint32 height)
+{
+    _width = width;
+    _height = height;
+    _rects.clear();
+}
+
+sint32 DirtyRegions::Add(sint32 left, sint32 top, sint32 right, sint32 bottom)
+{
+    left = Math::Max(left, 0);
+    top = Math::Max(top, 0);
+    right = Math::Min(right, _width);
+    bottom = Math::Min(bottom, _height);
+
+    if (left >= right) return 0;
+    if (top >= bottom) return 0;
+
+    DirtyRect rect = { left, top, right, bottom };
+    AddRect(rect);
+    return rect.GetArea();
+}
+
+void DirtyRegions::Clear()
+{
+    _rects.clear();
+}
+
+uint32 DirtyRegions::GetArea() const
+{
+    // Split the rectangles into columns at every vertical edge and add up the covered height of
+    // each column, there are at most MaxRects rectangles so this stays cheap
+    std::vector<sint32> edges;
+    for (const DirtyRect &rect : _rects)
+    {
+        edges.push_back(rect.Left);
+        edges.push_back(rect.Right);
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    uint32 area = 0;
+    std::vector<std::pair<sint32, sint32>> spans;
+    for (size_t i = 1; i < edges.size(); i++)
+    {
+        sint32 left = edges[i - 1];
+        sint32 right = edges[i];
+        spans.clear();
+        for (const DirtyRect &rect : _rects)
+        {
+            if (rect.Left <= left && rect.Right >= right)
+            {
+                spans.push_back(std::make_pair(rect.Top, rect.Bottom));
+            }
+        }
+        std::sort(spans.begin(), spans.end());
+
+        sint32 height = 0;
+        sint32 coveredTo = INT32_MIN;
+        for (const auto &span : spans)
+        {
+            sint32 top = Math::Max(span.first, coveredTo);
+            if (span.second > top)
+            {
+                height += span.second - top;
+                coveredTo = span.second;
+            }
+        }
+        area += (uint32)((right - left) * height);
+    }
+    return area;
+}
+
+void DirtyRegions::AddRect(DirtyRect rect)
+{
+    // Keep absorbing rectangles until the new one no longer overlaps or is close to any of them
+    bool merged;
+    do
+    {
+        merged = false;
+        for (size_t i = 0; i < _rects.size(); i++)
+        {
+            const DirtyRect &existing = _rects[i];
+            if (Contains(existing, rect))
+            {
+                return;
+            }
+            if (GetMergeCost(existing, rect) <= MergeSlackArea)
+            {
+                rect = GetUnion(existing, rect);
+                _rects[i] = _rects.back();
+                _rects.pop_back();
+                merged = true;
+                break;
+            }
+        }
+    }
+    while (merged);
+
+    if (_rects.size() >= MaxRects)
+    {
+        // Full, merge with whichever rectangle wastes the least area
+        size_t bestIndex = 0;
+        sint32 bestCost = INT32_MAX;
+        for (size_t i = 0; i < _rects.size(); i++)
+        {
+            sint32 cost = GetMergeCost(_rects[i], rect);
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestIndex = i;
+            }
+        }
+
+        DirtyRect merge = GetUnion(_rects[bestIndex], rect);
+        _rects[bestIndex] = _rects.back();
+        _rects.pop_back();
+        AddRect(merge);
+        return;
+    }
+
+    _rects.push_back(rect);
+}
@@ -0,0 +1,86 @@
+#pragma region Copyright (c) 2014-2016 OpenRCT2 Developers
+/*****************************************************************************
+ * OpenRCT2, an open source clone of Roller Coaster Tycoon 2.
+ *
+ * OpenRCT2 is the work of many authors, a full list can be found in contributors.md
+ * For more information, visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * A full copy of the GNU General Public License can be found in licence.txt
+ *****************************************************************************/
+#pragma endregion
+
+#pragma once
+
+#include <vector>
+#include "../../common.h"
+
+struct DirtyRect
+{
+    sint32 Left;
+    sint32 Top;
+    sint32 Right;   // Exclusive
+    sint32 Bottom;  // Exclusive
+
+    sint32 GetArea() const
+    {
+        return (Right - Left) * (Bottom - Top);
+    }
+};
+
+/**
+ * Tracks invalidated areas of the screen as a small list of rectangles. Invalidations that are
+ * close enough that redrawing the gap between them is cheaper than an extra redraw pass are
+ * merged into their union. The list is capped so a busy frame degrades to a few larger
+ * rectangles rather than hundreds of tiny ones.
+ */
+class DirtyRegions final
+{
+private:
+    // Up to this many pixels of not invalidated area may be redrawn to save a redraw pass
+    static constexpr sint32 MergeSlackArea = 64 * 64;
+    static constexpr size_t MaxRects = 32;
+
+    sint32                  _width = 0;
+    sint32                  _height = 0;
+    std::vector<DirtyRect>  _rects;
+    std::vector<DirtyRect>  _drawingRects;
+
+public:
+    void    SetSize(sint32 width, sint32 height);
+    /**
+     * Adds the given area clipped to the screen and returns the number of pixels it covers,
+     * before any merging.
+     */
+    sint32  Add(sint32 left, sint32 top, sint32 right, sint32 bottom);
+    void    Clear();
+    bool    IsEmpty() const { return _rects.empty(); }
+
+    /**
+     * Number of pixels covered by the current rectangles. Pixels covered by more than one
+     * rectangle are only counted once.
+     */
+    uint32  GetArea() const;
+
+    /**
+     * Clears the list and calls func for each rectangle it contained. Rectangles added while
+     * iterating are kept for the next call.
+     */
+    template<typename TFunc>
+    void Flush(TFunc func)
+    {
+        _drawingRects.clear();
+        std::swap(_drawingRects, _rects);
+        for (const DirtyRect &rect : _drawingRects)
+        {
+            func(rect);
+        }
+    }
+
+private:
+    void AddRect(DirtyRect rect);
+};
@@ -20,6 +20,7 @@
 #include "../IDrawingContext.h"
 #include "../IDrawingEngine.h"
 #include "../Rain.h"
+#include "DirtyRegions.h"
 
 extern "C"
 {
@@ -30,22 +31,71 @@ extern "C"
     #include "../../interface/window.h"
     #include "../../intro.h"
     #include "../../rct2.h"
+    #include "../../util/util.h"
     #include "../drawing.h"
     #include "../lightfx.h"
 }
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define OPENRCT2_AVX2
+    #define OPENRCT2_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <immintrin.h>
+    #define OPENRCT2_AVX2
+    #define OPENRCT2_AVX2_TARGET
+#endif
+
 class SoftwareDrawingEngine;
 
-struct DirtyGrid
+typedef void (* PaletteRowConverter)(uint32 * dst, const uint8 * src, sint32 width, const uint32 * palette);
+
+static void ConvertPaletteRow(uint32 * dst, const uint8 * src, sint32 width, const uint32 * palette)
 {
-    uint32  BlockShiftX;
-    uint32  BlockShiftY;
-    uint32  BlockWidth;
-    uint32  BlockHeight;
-    uint32  BlockColumns;
-    uint32  BlockRows;
-    uint8 * Blocks;
-};
+    sint32 x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        dst[x + 0] = palette[src[x + 0]];
+        dst[x + 1] = palette[src[x + 1]];
+        dst[x + 2] = palette[src[x + 2]];
+        dst[x + 3] = palette[src[x + 3]];
+    }
+    for (; x < width; x++)
+    {
+        dst[x] = palette[src[x]];
+    }
+}
+
+#ifdef OPENRCT2_AVX2
+OPENRCT2_AVX2_TARGET
+static void ConvertPaletteRowAVX2(uint32 * dst, const uint8 * src, sint32 width, const uint32 * palette)
+{
+    // Widen 8 palette indices at a time and gather their mapped colours
+    sint32 x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i indices8 = _mm_loadl_epi64((const __m128i *)(src + x));
+        __m256i indices = _mm256_cvtepu8_epi32(indices8);
+        __m256i colours = _mm256_i32gather_epi32((const int *)palette, indices, 4);
+        _mm256_storeu_si256((__m256i *)(dst + x), colours);
+    }
+    for (; x < width; x++)
+    {
+        dst[x] = palette[src[x]];
+    }
+}
+#endif
+
+static PaletteRowConverter GetPaletteRowConverter()
+{
+#ifdef OPENRCT2_AVX2
+    if (avx2_available())
+    {
+        return ConvertPaletteRowAVX2;
+    }
+#endif
+    return ConvertPaletteRow;
+}
 
 class RainDrawer final : public IRainDrawer
 {
@@ -63,6 +113,12 @@ private:
     RainPixel *         _rainPixels         = nullptr;
     rct_drawpixelinfo * _screenDPI          = nullptr;
 
+    // Screen area covered by the rain currently drawn
+    sint32  _drawnLeft      = INT32_MAX;
+    sint32  _drawnTop       = INT32_MAX;
+    sint32  _drawnRight     = INT32_MIN;
+    sint32  _drawnBottom    = INT32_MIN;
+
 public:
     RainDrawer()
     {
@@ -96,6 +152,11 @@ public:
         uint8 patternStartXOffset = xStart % patternXSpace;
         uint8 patternStartYOffset = yStart % patternYSpace;
 
+        _drawnLeft = Math::Min(_drawnLeft, x);
+        _drawnTop = Math::Min(_drawnTop, y);
+        _drawnRight = Math::Max(_drawnRight, x + width);
+        _drawnBottom = Math::Max(_drawnBottom, y + height);
+
         uint32 pixelOffset = (_screenDPI->pitch + _screenDPI->width) * y + x;
         uint8 patternYPos = patternStartYOffset % patternYSpace;
 
@@ -153,6 +214,23 @@ public:
             }
             _rainPixelsCount = 0;
         }
+        _drawnLeft = INT32_MAX;
+        _drawnTop = INT32_MAX;
+        _drawnRight = INT32_MIN;
+        _drawnBottom = INT32_MIN;
+    }
+
+    bool GetDrawnArea(sint32 * left, sint32 * top, sint32 * right, sint32 * bottom) const
+    {
+        if (_drawnLeft >= _drawnRight || _drawnTop >= _drawnBottom)
+        {
+            return false;
+        }
+        *left = _drawnLeft;
+        *top = _drawnTop;
+        *right = _drawnRight;
+        *bottom = _drawnBottom;
+        return true;
     }
 };
 
@@ -198,6 +276,8 @@ private:
     uint32              _lightPaletteHWMapped[256] = { 0 };
     bool                _lastLightFXenabled = false;
 #endif
+    PaletteRowConverter _convertPaletteRow      = nullptr;
+    bool                _textureFullyDirty      = true;
 
     // Steam overlay checking
     uint32  _pixelBeforeOverlay     = 0;
@@ -211,7 +291,10 @@ private:
     size_t  _bitsSize   = 0;
     uint8 * _bits       = nullptr;
 
-    DirtyGrid   _dirtyGrid  = { 0 };
+    DirtyRegions        _dirtyRegions;
+    DirtyRegions        _textureDirtyRegions;   // Changed since the last upload to the screen texture
+    dirty_region_stats  _frameStats     = { 0 };
+    dirty_region_stats  _lastFrameStats = { 0 };
 
     rct_drawpixelinfo _bitsDPI  = { 0 };
 
@@ -223,6 +306,7 @@ public:
     {
         _hardwareDisplay = hardwareDisplay;
         _drawingContext = new SoftwareDrawingContext(this);
+        _convertPaletteRow = GetPaletteRowConverter();
 #ifdef __ENABLE_LIGHTFX__
         _lastLightFXenabled = (gConfigGeneral.enable_light_fx != 0);
 #endif
@@ -231,7 +315,6 @@ public:
     ~SoftwareDrawingEngine() override
     {
         delete _drawingContext;
-        delete [] _dirtyGrid.Blocks;
         delete [] _bits;
         SDL_FreeSurface(_surface);
         SDL_FreeSurface(_RGBASurface);
@@ -315,7 +398,13 @@ public:
             {
                 for (sint32 i = 0; i < 256; i++)
                 {
-                    _paletteHWMapped[i] = SDL_MapRGB(_screenTextureFormat, palette[i].r, palette[i].g, palette[i].b);
+                    uint32 colour = SDL_MapRGB(_screenTextureFormat, palette[i].r, palette[i].g, palette[i].b);
+                    if (_paletteHWMapped[i] != colour)
+                    {
+                        // Every pixel using this index has to be converted again
+                        _paletteHWMapped[i] = colour;
+                        _textureFullyDirty = true;
+                    }
                 }
 
 #ifdef __ENABLE_LIGHTFX__
@@ -324,7 +413,12 @@ public:
                     const SDL_Color * lightPalette = lightfx_get_palette();
                     for (sint32 i = 0; i < 256; i++)
                     {
-                        _lightPaletteHWMapped[i] = SDL_MapRGBA(_screenTextureFormat, lightPalette[i].r, lightPalette[i].g, lightPalette[i].b, lightPalette[i].a);
+                        uint32 colour = SDL_MapRGBA(_screenTextureFormat, lightPalette[i].r, lightPalette[i].g, lightPalette[i].b, lightPalette[i].a);
+                        if (_lightPaletteHWMapped[i] != colour)
+                        {
+                            _lightPaletteHWMapped[i] = colour;
+                            _textureFullyDirty = true;
+                        }
                     }
                 }
 #endif
@@ -354,38 +448,16 @@ public:
 
     void Invalidate(sint32 left, sint32 top, sint32 right, sint32 bottom) override
     {
-        left = Math::Max(left, 0);
-        top = Math::Max(top, 0);
-        right = Math::Min(right, (sint32)_width);
-        bottom = Math::Min(bottom, (sint32)_height);
-
-        if (left >= right) return;
-        if (top >= bottom) return;
-
-        right--;
-        bottom--;
-
-        left >>= _dirtyGrid.BlockShiftX;
-        right >>= _dirtyGrid.BlockShiftX;
-        top >>= _dirtyGrid.BlockShiftY;
-        bottom >>= _dirtyGrid.BlockShiftY;
-
-        uint32 dirtyBlockColumns = _dirtyGrid.BlockColumns;
-        uint8 * screenDirtyBlocks = _dirtyGrid.Blocks;
-        for (sint16 y = top; y <= bottom; y++)
-        {
-            uint32 yOffset = y * dirtyBlockColumns;
-            for (sint16 x = left; x <= right; x++)
-            {
-                screenDirtyBlocks[yOffset + x] = 0xFF;
-            }
-        }
+        // Counted as requested, the merged rectangles may cover more than was invalidated
+        _frameStats.invalidated_area += _dirtyRegions.Add(left, top, right, bottom);
+        _textureDirtyRegions.Add(left, top, right, bottom);
     }
 
     void Draw() override
     {
         if (gIntroState != INTRO_STATE_NONE) {
             intro_draw(&_bitsDPI);
+            _textureFullyDirty = true;
         } else {
 #ifdef __ENABLE_LIGHTFX__
             // HACK we need to re-configure the bits if light fx has been enabled / disabled
@@ -395,6 +467,7 @@ public:
 #endif
 
             _rainDrawer.SetDPI(&_bitsDPI);
+            InvalidateRainTexture();
             _rainDrawer.Restore();
 
             ResetWindowVisbilities();
@@ -411,6 +484,7 @@ public:
             gfx_invalidate_pickedup_peep();
 
             DrawRain(&_bitsDPI, &_rainDrawer);
+            InvalidateRainTexture();
 
             rct2_draw(&_bitsDPI);
         }
@@ -423,6 +497,9 @@ public:
         {
             Display();
         }
+
+        _lastFrameStats = _frameStats;
+        _frameStats = { 0 };
     }
 
     void CopyRect(sint32 x, sint32 y, sint32 width, sint32 height, sint32 dx, sint32 dy) override
@@ -462,6 +539,8 @@ public:
             to += stride;
             from += stride;
         }
+
+        _textureDirtyRegions.Add(x, y, x + width, y + height);
     }
 
     sint32 Screenshot() override
@@ -490,6 +569,12 @@ public:
         // Not applicable for this engine
     }
 
+    bool GetDirtyRegionStats(dirty_region_stats * stats) override
+    {
+        *stats = _lastFrameStats;
+        return true;
+    }
+
     rct_drawpixelinfo * GetDPI()
     {
         return &_bitsDPI;
@@ -546,7 +631,10 @@ private:
         dpi->height = height;
         dpi->pitch = _pitch - width;
 
-        ConfigureDirtyGrid();
+        _dirtyRegions.SetSize(width, height);
+        _dirtyRegions.Add(0, 0, width, height);
+        _textureDirtyRegions.SetSize(width, height);
+        _textureFullyDirty = true;
 
 #ifdef __ENABLE_LIGHTFX__
         if (gConfigGeneral.enable_light_fx)
@@ -556,17 +644,13 @@ private:
 #endif
     }
 
-    void ConfigureDirtyGrid()
+    void InvalidateRainTexture()
     {
-        _dirtyGrid.BlockShiftX = 7;
-        _dirtyGrid.BlockShiftY = 6;
-        _dirtyGrid.BlockWidth = 1 << _dirtyGrid.BlockShiftX;
-        _dirtyGrid.BlockHeight = 1 << _dirtyGrid.BlockShiftY;
-        _dirtyGrid.BlockColumns = (_width >> _dirtyGrid.BlockShiftX) + 1;
-        _dirtyGrid.BlockRows = (_height >> _dirtyGrid.BlockShiftY) + 1;
-
-        delete [] _dirtyGrid.Blocks;
-        _dirtyGrid.Blocks = new uint8[_dirtyGrid.BlockColumns * _dirtyGrid.BlockRows];
+        sint32 left, top, right, bottom;
+        if (_rainDrawer.GetDrawnArea(&left, &top, &right, &bottom))
+        {
+            _textureDirtyRegions.Add(left, top, right, bottom);
+        }
     }
 
     static void ResetWindowVisbilities()
@@ -581,77 +665,27 @@ private:
 
     void DrawAllDirtyBlocks()
     {
-        uint32  dirtyBlockColumns = _dirtyGrid.BlockColumns;
-        uint32  dirtyBlockRows = _dirtyGrid.BlockRows;
-        uint8 * dirtyBlocks = _dirtyGrid.Blocks;
-
-        for (uint32 x = 0; x < dirtyBlockColumns; x++)
+        _frameStats.merged_area += _dirtyRegions.GetArea();
+        _dirtyRegions.Flush([this](const DirtyRect &rect) -> void
         {
-            for (uint32 y = 0; y < dirtyBlockRows; y++)
-            {
-                uint32 yOffset = y * dirtyBlockColumns;
-                if (dirtyBlocks[yOffset + x] == 0)
-                {
-                    continue;
-                }
-
-                // Determine columns
-                uint32 xx;
-                for (xx = x; xx < dirtyBlockColumns; xx++)
-                {
-                    if (dirtyBlocks[yOffset + xx] == 0)
-                    {
-                        break;
-                    }
-                }
-                uint32 columns = xx - x;
-
-                // Check rows
-                uint32 yy;
-                for (yy = y; yy < dirtyBlockRows; yy++)
-                {
-                    uint32 yyOffset = yy * dirtyBlockColumns;
-                    for (xx = x; xx < x + columns; xx++)
-                    {
-                        if (dirtyBlocks[yyOffset + xx] == 0)
-                        {
-                            goto endRowCheck;
-                        }
-                    }
-                }
-
-            endRowCheck:
-                uint32 rows = yy - y;
-                DrawDirtyBlocks(x, y, columns, rows);
-            }
-        }
+            DrawDirtyRect(rect);
+        });
     }
 
-    void DrawDirtyBlocks(uint32 x, uint32 y, uint32 columns, uint32 rows)
+    void DrawDirtyRect(const DirtyRect &rect)
     {
-        uint32  dirtyBlockColumns = _dirtyGrid.BlockColumns;
-        uint8 * screenDirtyBlocks = _dirtyGrid.Blocks;
-
-        // Unset dirty blocks
-        for (uint32 top = y; top < y + (uint32)rows; top++)
-        {
-            uint32 topOffset = top * dirtyBlockColumns;
-            for (uint32 left = x; left < x + (uint32)columns; left++)
-            {
-                screenDirtyBlocks[topOffset + left] = 0;
-            }
-        }
-
-        // Determine region in pixels
-        uint32 left = Math::Max<uint32>(0, x * _dirtyGrid.BlockWidth);
-        uint32 top = Math::Max<uint32>(0, y * _dirtyGrid.BlockHeight);
-        uint32 right = Math::Min((uint32)gScreenWidth, left + (columns * _dirtyGrid.BlockWidth));
-        uint32 bottom = Math::Min((uint32)gScreenHeight, top + (rows * _dirtyGrid.BlockHeight));
+        sint32 left = rect.Left;
+        sint32 top = rect.Top;
+        sint32 right = Math::Min(gScreenWidth, rect.Right);
+        sint32 bottom = Math::Min(gScreenHeight, rect.Bottom);
         if (right <= left || bottom <= top)
         {
             return;
         }
 
+        _frameStats.redrawn_area += (right - left) * (bottom - top);
+        _frameStats.redrawn_regions++;
+
         // Draw region
         window_draw_all(&_bitsDPI, left, top, right, bottom);
     }
@@ -716,12 +750,12 @@ private:
 #ifdef __ENABLE_LIGHTFX__
         if (gConfigGeneral.enable_light_fx)
         {
-            lightfx_render_to_texture(_screenTexture, _bits, _width, _height, _paletteHWMapped, _lightPaletteHWMapped);
+            CopyDirtyBitsToTextureWithLights();
         }
         else
 #endif
         {
-            CopyBitsToTexture(_screenTexture, _bits, (sint32)_width, (sint32)_height, _paletteHWMapped);
+            CopyDirtyBitsToTexture();
         }
         SDL_RenderCopy(_sdlRenderer, _screenTexture, nullptr, nullptr);
 
@@ -738,49 +772,98 @@ private:
         }
     }
 
-    void CopyBitsToTexture(SDL_Texture * texture, uint8 * src, sint32 width, sint32 height, uint32 * palette)
+    void CopyDirtyBitsToTexture()
+    {
+        if (_textureFullyDirty)
+        {
+            _textureDirtyRegions.Clear();
+            CopyBitsToTexture(_screenTexture, 0, 0, (sint32)_width, (sint32)_height);
+            _textureFullyDirty = false;
+        }
+        else
+        {
+            _textureDirtyRegions.Flush([this](const DirtyRect &rect) -> void
+            {
+                CopyBitsToTexture(_screenTexture, rect.Left, rect.Top, rect.Right - rect.Left, rect.Bottom - rect.Top);
+            });
+        }
+    }
+
+#ifdef __ENABLE_LIGHTFX__
+    void CopyDirtyBitsToTextureWithLights()
+    {
+        lightfx_update_frame();
+        if (_textureFullyDirty)
+        {
+            _textureDirtyRegions.Clear();
+            SDL_Rect rect = { 0, 0, (sint32)_width, (sint32)_height };
+            lightfx_render_to_texture(_screenTexture, _bits, _width, _height, _paletteHWMapped, _lightPaletteHWMapped, &rect);
+            _textureFullyDirty = false;
+        }
+        else
+        {
+            // Pixels that are lit differently than in the last frame have to be converted again as well
+            uint32 numChangedAreas;
+            const lightfx_area * changedAreas = lightfx_get_changed_areas(&numChangedAreas);
+            for (uint32 i = 0; i < numChangedAreas; i++)
+            {
+                const lightfx_area * area = &changedAreas[i];
+                _textureDirtyRegions.Add(area->left, area->top, area->right, area->bottom);
+            }
+
+            _textureDirtyRegions.Flush([this](const DirtyRect &rect) -> void
+            {
+                SDL_Rect sdlRect = { rect.Left, rect.Top, rect.Right - rect.Left, rect.Bottom - rect.Top };
+                lightfx_render_to_texture(_screenTexture, _bits, _width, _height, _paletteHWMapped, _lightPaletteHWMapped, &sdlRect);
+            });
+        }
+    }
+#endif
+
+    void CopyBitsToTexture(SDL_Texture * texture, sint32 left, sint32 top, sint32 width, sint32 height)
     {
+        const uint32 * palette = _paletteHWMapped;
+        const uint8 * src = _bits + (top * _pitch) + left;
+
+        SDL_Rect rect = { left, top, width, height };
         void *  pixels;
-        sint32     pitch;
-        if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) == 0)
+        sint32  pitch;
+        if (SDL_LockTexture(texture, &rect, &pixels, &pitch) == 0)
         {
-            sint32 padding = pitch - (width * 4);
-            if (pitch == width * 4)
+            uint8 * dst = (uint8 *)pixels;
+            switch (_screenTextureFormat->BytesPerPixel)
             {
-                uint32 * dst = (uint32 *)pixels;
-                for (sint32 i = width * height; i > 0; i--)
+            case 4:
+                for (sint32 y = 0; y < height; y++)
                 {
-                    *dst++ = palette[*src++];
+                    _convertPaletteRow((uint32 *)dst, src, width, palette);
+                    src += _pitch;
+                    dst += pitch;
                 }
-            }
-            else
-            {
-                if (pitch == (width * 2) + padding)
+                break;
+            case 2:
+                for (sint32 y = 0; y < height; y++)
                 {
-                    uint16 * dst = (uint16 *)pixels;
-                    for (sint32 y = height; y > 0; y--)
+                    uint16 * dst16 = (uint16 *)dst;
+                    for (sint32 x = 0; x < width; x++)
                     {
-                        for (sint32 x = width; x > 0; x--)
-                        {
-                            const uint8 lower = *(uint8 *)(&palette[*src++]);
-                            const uint8 upper = *(uint8 *)(&palette[*src++]);
-                            *dst++ = (lower << 8) | upper;
-                        }
-                        dst = (uint16*)(((uint8 *)dst) + padding);
+                        dst16[x] = (uint16)palette[src[x]];
                     }
+                    src += _pitch;
+                    dst += pitch;
                 }
-                else if (pitch == width + padding)
+                break;
+            case 1:
+                for (sint32 y = 0; y < height; y++)
                 {
-                    uint8 * dst = (uint8 *)pixels;
-                    for (sint32 y = height; y > 0; y--)
+                    for (sint32 x = 0; x < width; x++)
                     {
-                        for (sint32 x = width; x > 0; x--)
-                        {
-                            *dst++ = *(uint8 *)(&palette[*src++]);
-                        }
-                        dst += padding;
+                        dst[x] = (uint8)palette[src[x]];
                     }
+                    src += _pitch;
+                    dst += pitch;
                 }
+                break;
             }
             SDL_UnlockTexture(texture);
         }
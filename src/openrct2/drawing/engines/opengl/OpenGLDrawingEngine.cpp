@@ -403,6 +403,12 @@ public:
                        ->InvalidateImage(image);
     }
 
+    bool GetDirtyRegionStats(dirty_region_stats * stats) override
+    {
+        // Not applicable for this engine, the whole screen is redrawn every frame
+        return false;
+    }
+
     rct_drawpixelinfo * GetDPI()
     {
         return &_bitsDPI;
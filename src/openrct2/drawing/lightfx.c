@@ -27,6 +27,11 @@
 #include "drawing.h"
 #include "lightfx.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define LIGHTFX_SSE2
+#endif
+
 static uint8 _bakedLightTexture_lantern_0[32*32];
 static uint8 _bakedLightTexture_lantern_1[64*64];
 static uint8 _bakedLightTexture_lantern_2[128*128];
@@ -62,6 +67,26 @@ static lightlist_entry	*_LightListFront;
 static uint32			LightListCurrentCountBack;
 static uint32			LightListCurrentCountFront;
 
+typedef struct lightfx_drawn_light {
+	sint16	x, y;		// Top left corner of the light texture on the screen
+	uint8	lightType;
+	uint8	lightIntensity;
+} lightfx_drawn_light;
+
+// Lights drawn to the light buffer in the current and the previous frame, used to find the areas
+// of the screen that are lit differently
+static lightfx_drawn_light	_DrawnLightsA[16000];
+static lightfx_drawn_light	_DrawnLightsB[16000];
+
+static lightfx_drawn_light	*_DrawnLightsPrevious	= _DrawnLightsA;
+static lightfx_drawn_light	*_DrawnLightsCurrent	= _DrawnLightsB;
+
+static uint32			DrawnLightCountPrevious	= 0;
+static uint32			DrawnLightCountCurrent	= 0;
+
+static lightfx_area		_ChangedAreas[2 * 16000];
+static uint32			ChangedAreaCount = 0;
+
 static sint16			_current_view_x_front			= 0;
 static sint16			_current_view_y_front			= 0;
 static uint8			_current_view_rotation_front	= 0;
@@ -187,10 +212,19 @@ void lightfx_prepare_light_list()
 		posOnScreenX >>= _current_view_zoom_front;
 		posOnScreenY >>= _current_view_zoom_front;
 
-		if ((posOnScreenX < -128) ||
-			(posOnScreenY < -128) ||
-			(posOnScreenX > _pixelInfo.width + 128) ||
-			(posOnScreenY > _pixelInfo.height + 128)) {
+		// Cull lights that are too small to draw at this zoom or whose texture, at the size it
+		// will be drawn with, does not overlap the screen
+		sint32 lightSize = (entry->lightType & 0x3) - _current_view_zoom_front;
+		if (lightSize < 0) {
+			entry->lightType = LIGHTFX_LIGHT_TYPE_NONE;
+			continue;
+		}
+
+		sint32 lightRadius = 16 << lightSize;
+		if ((posOnScreenX + lightRadius <= 0) ||
+			(posOnScreenY + lightRadius <= 0) ||
+			(posOnScreenX - lightRadius >= _pixelInfo.width) ||
+			(posOnScreenY - lightRadius >= _pixelInfo.height)) {
 			entry->lightType = LIGHTFX_LIGHT_TYPE_NONE;
 			continue;
 		}
@@ -452,6 +486,89 @@ void lightfx_update_viewport_settings()
 	}
 }
 
+/**
+ * Adds a row of a light texture to the light buffer, saturating at 0xFF.
+ */
+static void add_light_row(uint8 *dst, const uint8 *src, sint32 width)
+{
+	sint32 x = 0;
+#ifdef LIGHTFX_SSE2
+	for (; x + 16 <= width; x += 16) {
+		__m128i light = _mm_loadu_si128((const __m128i *)(src + x));
+		__m128i buffer = _mm_loadu_si128((const __m128i *)(dst + x));
+		_mm_storeu_si128((__m128i *)(dst + x), _mm_adds_epu8(buffer, light));
+	}
+#endif
+	for (; x < width; x++) {
+		dst[x] = min(0xFF, dst[x] + src[x]);
+	}
+}
+
+/**
+ * Adds a row of a light texture scaled by multiplier / 256 to the light buffer, saturating at 0xFF.
+ * The multiplier must not be more than 0x100.
+ */
+static void add_light_row_scaled(uint8 *dst, const uint8 *src, sint32 width, uint16 multiplier)
+{
+	sint32 x = 0;
+#ifdef LIGHTFX_SSE2
+	// The products of two bytes fit in 16 bits as long as the multiplier is below 0x100
+	if (multiplier < 0x100) {
+		__m128i zero = _mm_setzero_si128();
+		__m128i factor = _mm_set1_epi16(multiplier);
+		for (; x + 16 <= width; x += 16) {
+			__m128i light = _mm_loadu_si128((const __m128i *)(src + x));
+			__m128i lightLo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(light, zero), factor), 8);
+			__m128i lightHi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(light, zero), factor), 8);
+			__m128i buffer = _mm_loadu_si128((const __m128i *)(dst + x));
+			_mm_storeu_si128((__m128i *)(dst + x), _mm_adds_epu8(buffer, _mm_packus_epi16(lightLo, lightHi)));
+		}
+	}
+#endif
+	for (; x < width; x++) {
+		dst[x] = min(0xFF, dst[x] + ((src[x] * multiplier) >> 8));
+	}
+}
+
+static void add_changed_area(const lightfx_drawn_light *light)
+{
+	sint16 size = 32 << (light->lightType & 0x3);
+	lightfx_area *area = &_ChangedAreas[ChangedAreaCount++];
+	area->left = light->x;
+	area->top = light->y;
+	area->right = light->x + size;
+	area->bottom = light->y + size;
+}
+
+/**
+ * Collects the areas of the lights that were added, removed or changed since the previous frame. The
+ * light buffer is the same as in the previous frame everywhere else.
+ */
+static void update_changed_areas()
+{
+	ChangedAreaCount = 0;
+
+	uint32 count = max(DrawnLightCountPrevious, DrawnLightCountCurrent);
+	for (uint32 i = 0; i < count; i++) {
+		const lightfx_drawn_light *previous = i < DrawnLightCountPrevious ? &_DrawnLightsPrevious[i] : NULL;
+		const lightfx_drawn_light *current = i < DrawnLightCountCurrent ? &_DrawnLightsCurrent[i] : NULL;
+		if (previous != NULL && current != NULL &&
+			previous->x == current->x &&
+			previous->y == current->y &&
+			previous->lightType == current->lightType &&
+			previous->lightIntensity == current->lightIntensity) {
+			continue;
+		}
+
+		if (previous != NULL) {
+			add_changed_area(previous);
+		}
+		if (current != NULL) {
+			add_changed_area(current);
+		}
+	}
+}
+
 void lightfx_render_lights_to_frontbuffer()
 {
 	if (_light_rendered_buffer_front == NULL) {
@@ -460,6 +577,12 @@ void lightfx_render_lights_to_frontbuffer()
 
 	memset(_light_rendered_buffer_front, 0, _pixelInfo.width * _pixelInfo.height);
 
+	lightfx_drawn_light *drawnLightsTmp = _DrawnLightsPrevious;
+	_DrawnLightsPrevious = _DrawnLightsCurrent;
+	_DrawnLightsCurrent = drawnLightsTmp;
+	DrawnLightCountPrevious = DrawnLightCountCurrent;
+	DrawnLightCountCurrent = 0;
+
 	_lightPolution_back = 0;
 
 //	log_warning("%i lights", LightListCurrentCountFront);
@@ -470,7 +593,6 @@ void lightfx_render_lights_to_frontbuffer()
 		uint32		bufReadWidth, bufReadHeight;
 		sint32		bufWriteX, bufWriteY;
 		sint32		bufWriteWidth, bufWriteHeight;
-		uint32		bufReadSkip, bufWriteSkip;
 
 		lightlist_entry	* entry = &_LightListFront[light];
 
@@ -575,34 +697,35 @@ void lightfx_render_lights_to_frontbuffer()
 
 		_lightPolution_back += (bufWriteWidth * bufWriteHeight) / 256;
 
-		bufReadSkip		= bufReadWidth - bufWriteWidth;
-		bufWriteSkip	= _pixelInfo.width - bufWriteWidth;
+		lightfx_drawn_light *drawnLight = &_DrawnLightsCurrent[DrawnLightCountCurrent++];
+		drawnLight->x = bufWriteX;
+		drawnLight->y = bufWriteY;
+		drawnLight->lightType = entry->lightType;
+		drawnLight->lightIntensity = entry->lightIntensity;
 
 		if (entry->lightIntensity == 0xFF) {
 			for (sint32 y = 0; y < bufWriteHeight; y++) {
-				for (sint32 x = 0; x < bufWriteWidth; x++) {
-					*bufWriteBase = min(0xFF, *bufWriteBase + *bufReadBase);
-					bufWriteBase++;
-					bufReadBase++;
-				}
-
-				bufWriteBase	+= bufWriteSkip;
-				bufReadBase		+= bufReadSkip;
+				add_light_row(bufWriteBase, bufReadBase, bufWriteWidth);
+				bufWriteBase	+= _pixelInfo.width;
+				bufReadBase		+= bufReadWidth;
 			}
 		}
 		else {
 			for (sint32 y = 0; y < bufWriteHeight; y++) {
-				for (sint32 x = 0; x < bufWriteWidth; x++) {
-					*bufWriteBase = min(0xFF, *bufWriteBase + (((*bufReadBase) * (1 + entry->lightIntensity)) >> 8));
-					bufWriteBase++;
-					bufReadBase++;
-				}
-
-				bufWriteBase += bufWriteSkip;
-				bufReadBase += bufReadSkip;
+				add_light_row_scaled(bufWriteBase, bufReadBase, bufWriteWidth, 1 + entry->lightIntensity);
+				bufWriteBase	+= _pixelInfo.width;
+				bufReadBase		+= bufReadWidth;
 			}
 		}
 	}
+
+	update_changed_areas();
+}
+
+const lightfx_area * lightfx_get_changed_areas(uint32 * count)
+{
+	*count = ChangedAreaCount;
+	return _ChangedAreas;
 }
 
 void* lightfx_get_front_buffer()
@@ -995,47 +1118,91 @@ static uint8 mix_light(uint32 a, uint32 b, uint32 intensity)
 	return result;
 }
 
+/**
+ * Converts a row of the screen to the texture format, mixing in the light colours.
+ */
+static void mix_light_row(uint32 *dst, const uint8 *src, const uint8 *lightBits, sint32 width, const uint32 *palette, const uint32 *lightPalette)
+{
+	sint32 x = 0;
+#ifdef LIGHTFX_SSE2
+	// Does the same as mix_light for all channels of four pixels at a time
+	__m128i zero = _mm_setzero_si128();
+	for (; x + 4 <= width; x += 4) {
+		__m128i dark = _mm_setr_epi32(palette[src[x]], palette[src[x + 1]], palette[src[x + 2]], palette[src[x + 3]]);
+		__m128i light = _mm_setr_epi32(lightPalette[src[x]], lightPalette[src[x + 1]], lightPalette[src[x + 2]], lightPalette[src[x + 3]]);
+		sint16 i0 = lightBits[x] * 6;
+		sint16 i1 = lightBits[x + 1] * 6;
+		sint16 i2 = lightBits[x + 2] * 6;
+		sint16 i3 = lightBits[x + 3] * 6;
+		__m128i intensityLo = _mm_setr_epi16(i0, i0, i0, i0, i1, i1, i1, i1);
+		__m128i intensityHi = _mm_setr_epi16(i2, i2, i2, i2, i3, i3, i3, i3);
+
+		// The products need up to 19 bits, combine the high and low halves to shift them right by 8
+		__m128i lightLo = _mm_unpacklo_epi8(light, zero);
+		__m128i lightHi = _mm_unpackhi_epi8(light, zero);
+		__m128i mulLo = _mm_or_si128(
+			_mm_slli_epi16(_mm_mulhi_epu16(lightLo, intensityLo), 8),
+			_mm_srli_epi16(_mm_mullo_epi16(lightLo, intensityLo), 8));
+		__m128i mulHi = _mm_or_si128(
+			_mm_slli_epi16(_mm_mulhi_epu16(lightHi, intensityHi), 8),
+			_mm_srli_epi16(_mm_mullo_epi16(lightHi, intensityHi), 8));
+
+		// Sums are at most 255 + 1524 so saturating to unsigned bytes gives min(255, sum)
+		__m128i sumLo = _mm_add_epi16(_mm_unpacklo_epi8(dark, zero), mulLo);
+		__m128i sumHi = _mm_add_epi16(_mm_unpackhi_epi8(dark, zero), mulHi);
+		_mm_storeu_si128((__m128i *)(dst + x), _mm_packus_epi16(sumLo, sumHi));
+	}
+#endif
+	for (; x < width; x++) {
+		uint32 darkColour = palette[src[x]];
+		uint32 lightColour = lightPalette[src[x]];
+		uint8 lightIntensity = lightBits[x];
+
+		uint32 colour = 0;
+		if (lightIntensity == 0) {
+			colour = darkColour;
+		} else {
+			colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
+			colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
+			colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
+			colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
+		}
+		dst[x] = colour;
+	}
+}
+
+void lightfx_update_frame()
+{
+	lightfx_update_viewport_settings();
+	lightfx_swap_buffers();
+	lightfx_prepare_light_list();
+	lightfx_render_lights_to_frontbuffer();
+}
+
 void lightfx_render_to_texture(
 	SDL_Texture * texture,
 	uint8 * bits,
 	uint32 width,
 	uint32 height,
 	uint32 * palette,
-	uint32 * lightPalette)
+	uint32 * lightPalette,
+	const SDL_Rect * rect)
 {
-	lightfx_update_viewport_settings();
-	lightfx_swap_buffers();
-	lightfx_prepare_light_list();
-	lightfx_render_lights_to_frontbuffer();
-
 	uint8 * lightBits = (uint8 *)lightfx_get_front_buffer();
 	if (lightBits == NULL) {
 		return;
 	}
 
+	assert(rect->x >= 0 && rect->y >= 0 && (uint32)(rect->x + rect->w) <= width && (uint32)(rect->y + rect->h) <= height);
+
 	void * pixels;
 	sint32 pitch;
-	if (SDL_LockTexture(texture, NULL, &pixels, &pitch) == 0) {
-		for (uint32 y = 0; y < height; y++) {
+	if (SDL_LockTexture(texture, rect, &pixels, &pitch) == 0) {
+		for (sint32 y = 0; y < rect->h; y++) {
 			uintptr_t dstOffset = (uintptr_t)(y * pitch);
 			uint32 * dst = (uint32 *)((uintptr_t)pixels + dstOffset);
-			for (uint32 x = 0; x < width; x++) {
-				uint8 * src = &bits[y * width + x];
-				uint32 darkColour = palette[*src];
-				uint32 lightColour = lightPalette[*src];
-				uint8 lightIntensity = lightBits[y * width + x];
-
-				uint32 colour = 0;
-				if (lightIntensity == 0) {
-					colour = darkColour;
-				} else {
-					colour |= mix_light((darkColour >> 0) & 0xFF, (lightColour >> 0) & 0xFF, lightIntensity);
-					colour |= mix_light((darkColour >> 8) & 0xFF, (lightColour >> 8) & 0xFF, lightIntensity) << 8;
-					colour |= mix_light((darkColour >> 16) & 0xFF, (lightColour >> 16) & 0xFF, lightIntensity) << 16;
-					colour |= mix_light((darkColour >> 24) & 0xFF, (lightColour >> 24) & 0xFF, lightIntensity) << 24;
-				}
-				*dst++ = colour;
-			}
+			uint32 srcOffset = (rect->y + y) * width + rect->x;
+			mix_light_row(dst, &bits[srcOffset], &lightBits[srcOffset], rect->w, palette, lightPalette);
 		}
 		SDL_UnlockTexture(texture);
 	}
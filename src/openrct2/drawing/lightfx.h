@@ -45,6 +45,11 @@ enum LIGHTFX_LIGHT_QUALIFIER {
 	LIGHTFX_LIGHT_QUALIFIER_MAP			= 0x2
 };
 
+typedef struct lightfx_area {
+	sint16	left, top;
+	sint16	right, bottom;	// Exclusive, may lie outside of the screen
+} lightfx_area;
+
 void lightfx_init();
 
 void lightfx_update_buffers(rct_drawpixelinfo*);
@@ -53,6 +58,12 @@ void lightfx_prepare_light_list();
 void lightfx_swap_buffers();
 void lightfx_render_lights_to_frontbuffer();
 void lightfx_update_viewport_settings();
+void lightfx_update_frame();
+
+/**
+ * Returns the areas of the screen where the light buffer may differ from the previous frame.
+ */
+const lightfx_area * lightfx_get_changed_areas(uint32 * count);
 
 void* lightfx_get_front_buffer();
 const SDL_Color * lightfx_get_palette();
@@ -72,7 +83,8 @@ void lightfx_render_to_texture(
 	uint32 width,
 	uint32 height,
 	uint32 * palette,
-	uint32 * lightPalette);
+	uint32 * lightPalette,
+	const SDL_Rect * rect);
 
 #endif // __ENABLE_LIGHTFX__
 
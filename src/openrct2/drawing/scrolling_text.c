@@ -18,6 +18,7 @@
 #include "../config/Config.h"
 #include "../interface/colour.h"
 #include "../localisation/localisation.h"
+#include "../rct2.h"
 #include "../sprites.h"
 #include "drawing.h"
 
@@ -35,15 +36,166 @@ typedef struct rct_draw_scroll_text {
 assert_struct_size(rct_draw_scroll_text, 0xA12);
 #pragma pack(pop)
 
-#define MAX_SCROLLING_TEXT_ENTRIES 32
+// Entries are allocated in blocks as more scrolling text is visible at once. The first block uses the
+// image ids reserved in g1 for scrolling text, further blocks allocate their own image ids.
+#define SCROLLING_TEXT_BLOCK_SIZE 32
+#define MAX_SCROLLING_TEXT_BLOCKS 32
+#define MAX_SCROLLING_TEXT_ENTRIES (SCROLLING_TEXT_BLOCK_SIZE * MAX_SCROLLING_TEXT_BLOCKS)
+#define SCROLLING_TEXT_HASH_SIZE 1024
+
+typedef struct scrolling_text_entry {
+	rct_draw_scroll_text text;
+	uint32 image_id;
+	uint32 last_draw_count;
+	sint16 hash_next;
+	sint16 lru_prev;
+	sint16 lru_next;
+} scrolling_text_entry;
+
+static scrolling_text_entry *_scrollingTextBlocks[MAX_SCROLLING_TEXT_BLOCKS];
+static sint32 _scrollingTextBlockCount = 0;
+static sint16 _scrollingTextHash[SCROLLING_TEXT_HASH_SIZE];
+
+// Least recently used entry is at the tail
+static sint16 _scrollingTextLruHead = -1;
+static sint16 _scrollingTextLruTail = -1;
 
-static rct_draw_scroll_text _drawScrollTextList[MAX_SCROLLING_TEXT_ENTRIES];
 static uint8 _characterBitmaps[224 * 8];
 static uint32 _drawSCrollNextIndex = 0;
 
 void scrolling_text_set_bitmap_for_sprite(utf8 *text, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets);
 void scrolling_text_set_bitmap_for_ttf(utf8 *text, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets);
 
+static scrolling_text_entry *scrolling_text_get_entry(sint32 index)
+{
+	return &_scrollingTextBlocks[index / SCROLLING_TEXT_BLOCK_SIZE][index % SCROLLING_TEXT_BLOCK_SIZE];
+}
+
+static uint32 scrolling_text_hash(rct_string_id stringId, uint32 stringArgs0, uint32 stringArgs1, uint16 scroll, uint16 scrollingMode)
+{
+	uint32 hash = stringId;
+	hash = (hash * 31) ^ stringArgs0;
+	hash = (hash * 31) ^ stringArgs1;
+	hash = (hash * 31) ^ scroll;
+	hash = (hash * 31) ^ scrollingMode;
+	return (hash ^ (hash >> 16)) % SCROLLING_TEXT_HASH_SIZE;
+}
+
+static void scrolling_text_lru_unlink(sint32 index)
+{
+	scrolling_text_entry *entry = scrolling_text_get_entry(index);
+	if (entry->lru_prev != -1) {
+		scrolling_text_get_entry(entry->lru_prev)->lru_next = entry->lru_next;
+	} else {
+		_scrollingTextLruHead = entry->lru_next;
+	}
+	if (entry->lru_next != -1) {
+		scrolling_text_get_entry(entry->lru_next)->lru_prev = entry->lru_prev;
+	} else {
+		_scrollingTextLruTail = entry->lru_prev;
+	}
+	entry->lru_prev = -1;
+	entry->lru_next = -1;
+}
+
+static void scrolling_text_lru_push(sint32 index, bool front)
+{
+	scrolling_text_entry *entry = scrolling_text_get_entry(index);
+	if (front) {
+		entry->lru_prev = -1;
+		entry->lru_next = _scrollingTextLruHead;
+		if (_scrollingTextLruHead != -1) {
+			scrolling_text_get_entry(_scrollingTextLruHead)->lru_prev = (sint16)index;
+		} else {
+			_scrollingTextLruTail = (sint16)index;
+		}
+		_scrollingTextLruHead = (sint16)index;
+	} else {
+		entry->lru_prev = _scrollingTextLruTail;
+		entry->lru_next = -1;
+		if (_scrollingTextLruTail != -1) {
+			scrolling_text_get_entry(_scrollingTextLruTail)->lru_next = (sint16)index;
+		} else {
+			_scrollingTextLruHead = (sint16)index;
+		}
+		_scrollingTextLruTail = (sint16)index;
+	}
+}
+
+static void scrolling_text_hash_remove(sint32 index)
+{
+	scrolling_text_entry *entry = scrolling_text_get_entry(index);
+	rct_draw_scroll_text *scrollText = &entry->text;
+	uint32 hash = scrolling_text_hash(scrollText->string_id, scrollText->string_args_0, scrollText->string_args_1, scrollText->position, scrollText->mode);
+
+	sint16 *link = &_scrollingTextHash[hash];
+	while (*link != -1) {
+		if (*link == index) {
+			*link = entry->hash_next;
+			break;
+		}
+		link = &scrolling_text_get_entry(*link)->hash_next;
+	}
+	entry->hash_next = -1;
+}
+
+static void scrolling_text_reset_entry(scrolling_text_entry *entry)
+{
+	rct_g1_element *g1 = gfx_get_g1_element(entry->image_id);
+	g1->offset = entry->text.bitmap;
+	g1->width = 64;
+	g1->height = 40;
+	g1->offset[0] = 0xFF;
+	g1->offset[1] = 0xFF;
+	g1->offset[14] = 0;
+	g1->offset[15] = 0;
+	g1->offset[16] = 0;
+	g1->offset[17] = 0;
+
+	entry->text.string_id = STR_NONE;
+	entry->last_draw_count = 0;
+	entry->hash_next = -1;
+}
+
+/**
+ * Adds another block of entries, returns false if the maximum number of entries has been reached.
+ */
+static bool scrolling_text_add_block()
+{
+	if (_scrollingTextBlockCount >= MAX_SCROLLING_TEXT_BLOCKS) {
+		return false;
+	}
+
+	scrolling_text_entry *block = calloc(SCROLLING_TEXT_BLOCK_SIZE, sizeof(scrolling_text_entry));
+	if (block == NULL) {
+		return false;
+	}
+
+	uint32 baseImageId = SPR_SCROLLING_TEXT_START;
+	if (_scrollingTextBlockCount != 0) {
+		rct_g1_element images[SCROLLING_TEXT_BLOCK_SIZE] = { 0 };
+		for (sint32 i = 0; i < SCROLLING_TEXT_BLOCK_SIZE; i++) {
+			images[i].offset = block[i].text.bitmap;
+		}
+		baseImageId = gfx_object_allocate_images(images, SCROLLING_TEXT_BLOCK_SIZE);
+		if (baseImageId == UINT32_MAX) {
+			free(block);
+			return false;
+		}
+	}
+
+	sint32 firstIndex = _scrollingTextBlockCount * SCROLLING_TEXT_BLOCK_SIZE;
+	_scrollingTextBlocks[_scrollingTextBlockCount++] = block;
+	for (sint32 i = 0; i < SCROLLING_TEXT_BLOCK_SIZE; i++) {
+		block[i].image_id = baseImageId + i;
+		scrolling_text_reset_entry(&block[i]);
+
+		// Unused entries are the first to be reused
+		scrolling_text_lru_push(firstIndex + i, false);
+	}
+	return true;
+}
+
 void scrolling_text_initialise_bitmaps()
 {
 	uint8 drawingSurface[64];
@@ -74,41 +226,57 @@ void scrolling_text_initialise_bitmaps()
 		}
 	}
 
-	for (sint32 i = 0; i < MAX_SCROLLING_TEXT_ENTRIES; i++) {
-		rct_g1_element *g1 = &g1Elements[SPR_SCROLLING_TEXT_START + i];
-		g1->offset = _drawScrollTextList[i].bitmap;
-		g1->width = 64;
-		g1->height = 40;
-		g1->offset[0] = 0xFF;
-		g1->offset[1] = 0xFF;
-		g1->offset[14] = 0;
-		g1->offset[15] = 0;
-		g1->offset[16] = 0;
-		g1->offset[17] = 0;
+	memset(_scrollingTextHash, 0xFF, sizeof(_scrollingTextHash));
+	if (_scrollingTextBlockCount == 0) {
+		scrolling_text_add_block();
+	} else {
+		// Forget any text rendered with the previous font
+		_scrollingTextLruHead = -1;
+		_scrollingTextLruTail = -1;
+		for (sint32 i = 0; i < _scrollingTextBlockCount * SCROLLING_TEXT_BLOCK_SIZE; i++) {
+			scrolling_text_reset_entry(scrolling_text_get_entry(i));
+			scrolling_text_lru_push(i, false);
+		}
 	}
 }
 
+/**
+ * Frees the image ids allocated for scrolling text beyond the first block.
+ */
+void scrolling_text_dispose()
+{
+	for (sint32 i = 0; i < _scrollingTextBlockCount; i++) {
+		scrolling_text_entry *block = _scrollingTextBlocks[i];
+		if (i != 0) {
+			gfx_object_free_images(block[0].image_id, SCROLLING_TEXT_BLOCK_SIZE);
+		}
+		free(block);
+		_scrollingTextBlocks[i] = NULL;
+	}
+	_scrollingTextBlockCount = 0;
+	_scrollingTextLruHead = -1;
+	_scrollingTextLruTail = -1;
+	memset(_scrollingTextHash, 0xFF, sizeof(_scrollingTextHash));
+}
+
 static uint8 *font_sprite_get_codepoint_bitmap(sint32 codepoint)
 {
 	return &_characterBitmaps[font_sprite_get_codepoint_offset(codepoint) * 8];
 }
 
-
-static sint32 scrolling_text_get_matching_or_oldest(rct_string_id stringId, uint16 scroll, uint16 scrollingMode)
+/**
+ * Returns the image id of the matching entry, or -1 with the index of the entry to replace in outIndex.
+ */
+static sint32 scrolling_text_get_matching_or_oldest(rct_string_id stringId, uint16 scroll, uint16 scrollingMode, sint32 *outIndex)
 {
-	uint32 oldestId = 0xFFFFFFFF;
-	sint32 scrollIndex = -1;
-	for (sint32 i = 0; i < MAX_SCROLLING_TEXT_ENTRIES; i++) {
-		rct_draw_scroll_text *scrollText = &_drawScrollTextList[i];
-		if (oldestId >= scrollText->id) {
-			oldestId = scrollText->id;
-			scrollIndex = i;
-		}
+	uint32 stringArgs0, stringArgs1;
+	memcpy(&stringArgs0, gCommonFormatArgs + 0, sizeof(uint32));
+	memcpy(&stringArgs1, gCommonFormatArgs + 4, sizeof(uint32));
 
-		// If exact match return the matching index
-		uint32 stringArgs0, stringArgs1;
-		memcpy(&stringArgs0, gCommonFormatArgs + 0, sizeof(uint32));
-		memcpy(&stringArgs1, gCommonFormatArgs + 4, sizeof(uint32));
+	uint32 hash = scrolling_text_hash(stringId, stringArgs0, stringArgs1, scroll, scrollingMode);
+	for (sint32 i = _scrollingTextHash[hash]; i != -1; ) {
+		scrolling_text_entry *entry = scrolling_text_get_entry(i);
+		rct_draw_scroll_text *scrollText = &entry->text;
 		if (
 			scrollText->string_id == stringId &&
 			scrollText->string_args_0 == stringArgs0 &&
@@ -117,10 +285,23 @@ static sint32 scrolling_text_get_matching_or_oldest(rct_string_id stringId, uint
 			scrollText->mode == scrollingMode
 		) {
 			scrollText->id = _drawSCrollNextIndex;
-			return i + SPR_SCROLLING_TEXT_START;
+			entry->last_draw_count = gCurrentDrawCount;
+			scrolling_text_lru_unlink(i);
+			scrolling_text_lru_push(i, true);
+			return entry->image_id;
 		}
+		i = entry->hash_next;
 	}
-	return scrollIndex;
+
+	// If even the oldest entry is visible this frame, the cache is too small for the view
+	sint32 index = _scrollingTextLruTail;
+	if (scrolling_text_get_entry(index)->last_draw_count == gCurrentDrawCount && scrolling_text_add_block()) {
+		index = _scrollingTextLruTail;
+	}
+
+	scrolling_text_hash_remove(index);
+	*outIndex = index;
+	return -1;
 }
 
 static uint8 scrolling_text_get_colour(uint32 character)
@@ -1424,21 +1605,30 @@ sint32 scrolling_text_setup(rct_string_id stringId, uint16 scroll, uint16 scroll
 
 	_drawSCrollNextIndex++;
 
-	sint32 scrollIndex = scrolling_text_get_matching_or_oldest(stringId, scroll, scrollingMode);
-	if (scrollIndex >= SPR_SCROLLING_TEXT_START) return scrollIndex;
+	sint32 scrollIndex;
+	sint32 imageId = scrolling_text_get_matching_or_oldest(stringId, scroll, scrollingMode, &scrollIndex);
+	if (imageId != -1) return imageId;
 
 	// Setup scrolling text
 	uint32 stringArgs0, stringArgs1;
 	memcpy(&stringArgs0, gCommonFormatArgs + 0, sizeof(uint32));
 	memcpy(&stringArgs1, gCommonFormatArgs + 4, sizeof(uint32));
 
-	rct_draw_scroll_text* scrollText = &_drawScrollTextList[scrollIndex];
+	scrolling_text_entry *entry = scrolling_text_get_entry(scrollIndex);
+	rct_draw_scroll_text* scrollText = &entry->text;
 	scrollText->string_id = stringId;
 	scrollText->string_args_0 = stringArgs0;
 	scrollText->string_args_1 = stringArgs1;
 	scrollText->position = scroll;
 	scrollText->mode = scrollingMode;
 	scrollText->id = _drawSCrollNextIndex;
+	entry->last_draw_count = gCurrentDrawCount;
+
+	uint32 hash = scrolling_text_hash(stringId, stringArgs0, stringArgs1, scroll, scrollingMode);
+	entry->hash_next = _scrollingTextHash[hash];
+	_scrollingTextHash[hash] = (sint16)scrollIndex;
+	scrolling_text_lru_unlink(scrollIndex);
+	scrolling_text_lru_push(scrollIndex, true);
 
 	// Create the string to draw
 	utf8 scrollString[256];
@@ -1453,9 +1643,8 @@ sint32 scrolling_text_setup(rct_string_id stringId, uint16 scroll, uint16 scroll
 		scrolling_text_set_bitmap_for_sprite(scrollString, scroll, scrollText->bitmap, scrollingModePositions);
 	}
 
-	uint32 imageId = SPR_SCROLLING_TEXT_START + scrollIndex;
-	drawing_engine_invalidate_image(imageId);
-	return imageId;
+	drawing_engine_invalidate_image(entry->image_id);
+	return entry->image_id;
 }
 
 void scrolling_text_set_bitmap_for_sprite(utf8 *text, sint32 scroll, uint8 *bitmap, const sint16 *scrollPositionOffsets)
@@ -18,9 +18,11 @@
 #include "../common.h"
 #include "../core/FileStream.hpp"
 #include "../core/Memory.hpp"
+#include "../core/MemoryMappedFile.h"
 #include "../core/Util.hpp"
 #include "../OpenRCT2.h"
 #include "../sprites.h"
+#include "SpriteCache.h"
 
 extern "C"
 {
@@ -36,6 +38,12 @@ extern "C"
     static rct_gx   _g2;
     static rct_gx   _csg;
 
+    static MemoryMappedFile * _g1File = nullptr;
+    static MemoryMappedFile * _g2File = nullptr;
+    static MemoryMappedFile * _csgFile = nullptr;
+
+    static SpriteCache _spriteCache;
+
     #ifdef NO_RCT2
         rct_g1_element * g1Elements = nullptr;
     #else
@@ -75,6 +83,28 @@ extern "C"
         Memory::Free(g1Elements32);
     }
 
+    /**
+     * Maps the file containing the sprite data rather than reading it, so only the sprites that
+     * are actually drawn are ever loaded from disk.
+     */
+    static void * map_gxdat_data(const std::string &path, size_t offset, size_t length, MemoryMappedFile * * outFile)
+    {
+        auto file = new MemoryMappedFile(path);
+        if (file->GetLength() < offset + length)
+        {
+            delete file;
+            throw IOException("Sprite data in '" + path + "' is truncated.");
+        }
+        *outFile = file;
+        return (uint8 *)file->GetData() + offset;
+    }
+
+    static void unmap_gxdat_data(MemoryMappedFile * * file)
+    {
+        delete *file;
+        *file = nullptr;
+    }
+
     /**
      *
      *  rct2: 0x00678998
@@ -84,7 +114,8 @@ extern "C"
         log_verbose("gfx_load_g1()");
         try
         {
-            auto fs = FileStream(get_file_path(PATH_ID_G1), FILE_MODE_OPEN);
+            std::string path = get_file_path(PATH_ID_G1);
+            auto fs = FileStream(path, FILE_MODE_OPEN);
             rct_g1_header header = fs.ReadValue<rct_g1_header>();
 
             /* number of elements is stored in g1.dat, but because the entry
@@ -99,8 +130,8 @@ extern "C"
 #endif
             read_and_convert_gxdat(&fs, header.num_entries, g1Elements);
 
-            // Read element data
-            _g1Buffer = fs.ReadArray<uint8>(header.total_size);
+            // Map element data
+            _g1Buffer = map_gxdat_data(path, (size_t)fs.GetPosition(), header.total_size, &_g1File);
 
             // Fix entry data offsets
             for (uint32 i = 0; i < header.num_entries; i++)
@@ -122,7 +153,8 @@ extern "C"
 
     void gfx_unload_g1()
     {
-        SafeFree(_g1Buffer);
+        unmap_gxdat_data(&_g1File);
+        _g1Buffer = nullptr;
     #ifdef NO_RCT2
         SafeFree(g1Elements);
     #endif
@@ -131,13 +163,15 @@ extern "C"
     void gfx_unload_g2()
     {
         SafeFree(_g2.elements);
-        SafeFree(_g2.data);
+        unmap_gxdat_data(&_g2File);
+        _g2.data = nullptr;
     }
 
     void gfx_unload_csg()
     {
         SafeFree(_csg.elements);
-        SafeFree(_csg.data);
+        unmap_gxdat_data(&_csgFile);
+        _csg.data = nullptr;
     }
 
     bool gfx_load_g2()
@@ -157,8 +191,8 @@ extern "C"
             _g2.elements = Memory::AllocateArray<rct_g1_element>(_g2.header.num_entries);
             read_and_convert_gxdat(&fs, _g2.header.num_entries, _g2.elements);
 
-            // Read element data
-            _g2.data = fs.ReadArray<uint8>(_g2.header.total_size);
+            // Map element data
+            _g2.data = map_gxdat_data(path, (size_t)fs.GetPosition(), _g2.header.total_size, &_g2File);
 
             // Fix entry data offsets
             for (uint32 i = 0; i < _g2.header.num_entries; i++)
@@ -212,8 +246,8 @@ extern "C"
             _csg.elements = Memory::AllocateArray<rct_g1_element>(_csg.header.num_entries);
             read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, _csg.elements);
 
-            // Read element data
-            _csg.data = fileData.ReadArray<uint8>(_csg.header.total_size);
+            // Map element data
+            _csg.data = map_gxdat_data(pathData, 0, _csg.header.total_size, &_csgFile);
 
             // Fix entry data offsets
             for (uint32 i = 0; i < _csg.header.num_entries; i++)
@@ -381,6 +415,79 @@ extern "C"
         }
     }
 
+    /**
+     * Returns a key that identifies the palette gfx_draw_sprite_get_palette returns for the image, or 0 if
+     * sprites drawn with it can not be taken from the remapped sprite cache.
+     */
+    static uint32 gfx_draw_sprite_get_palette_key(sint32 image_id, uint32 tertiary_colour)
+    {
+        uint32 image_type = (image_id & 0xE0000000);
+        if (image_type & IMAGE_TYPE_TRANSPARENT)
+        {
+            // Mixes with the pixels already drawn
+            return 0;
+        }
+
+        if (!(image_type & IMAGE_TYPE_REMAP_2_PLUS))
+        {
+            if (!(image_type & IMAGE_TYPE_REMAP))
+            {
+                return 0;
+            }
+            return (1 << 24) | ((image_id >> 19) & 0x7F);
+        }
+
+        uint32 colours = ((image_id >> 19) & 0x1F) | (((image_id >> 24) & 0x1F) << 5);
+        if (image_type & IMAGE_TYPE_REMAP)
+        {
+            return (2 << 24) | colours;
+        }
+        return (3 << 24) | colours | ((tertiary_colour & 0xFF) << 10);
+    }
+
+    static void gfx_draw_sprite_palette_set_software_keyed(rct_drawpixelinfo *dpi, sint32 image_id, sint32 x, sint32 y, uint8* palette_pointer, uint8* unknown_pointer, uint32 palette_key);
+
+    /**
+     * Draws an RLE sprite on a zoomed out dpi from a copy that only contains the pixels that would be
+     * sampled at that zoom level. Takes the same parameters as gfx_rle_sprite_to_buffer. Returns false
+     * if the sprite has to be drawn the regular way instead, which is needed when the sprite is not
+     * aligned to the zoom, is clipped on the left (runs crossing the edge are sampled differently) or
+     * does not fit in the cache.
+     */
+    static bool gfx_rle_sprite_to_buffer_zoomed(uint32 image_element, const rct_g1_element *g1_source, uint32 palette_key, uint8 *dest_pointer, const uint8 *palette_pointer, const rct_drawpixelinfo *dpi, sint32 image_type, sint32 source_start_y, sint32 height, sint32 source_start_x, sint32 width)
+    {
+        sint32 zoom_level = dpi->zoom_level;
+        sint32 zoom_amount = 1 << zoom_level;
+        sint32 zoom_mask = zoom_amount - 1;
+        if (source_start_x != 0 || ((dpi->x | dpi->width | dpi->height) & zoom_mask)) {
+            return false;
+        }
+
+        // The same adjustment DrawRLESprite2 makes when the sprite starts between two zoomed rows
+        if (source_start_y < 0) {
+            source_start_y += zoom_amount;
+            dest_pointer += (dpi->width >> zoom_level) + dpi->pitch;
+            height -= zoom_amount;
+            if (height <= 0) {
+                return true;
+            }
+        }
+
+        sint32 row_phase = source_start_y & zoom_mask;
+        const rct_g1_element *zoomed = _spriteCache.GetZoomed(image_element, g1_source, palette_key, zoom_level, row_phase);
+        if (zoomed == nullptr) {
+            return false;
+        }
+
+        rct_drawpixelinfo zoomed_dpi = *dpi;
+        zoomed_dpi.width = dpi->width >> zoom_level;
+        zoomed_dpi.zoom_level = 0;
+        gfx_rle_sprite_to_buffer(zoomed->offset, dest_pointer, palette_pointer, &zoomed_dpi, image_type,
+            source_start_y >> zoom_level, (height + zoom_mask) >> zoom_level,
+            0, (width + zoom_mask) >> zoom_level);
+        return true;
+    }
+
     /**
      *
      *  rct2: 0x0067A28E
@@ -400,12 +507,12 @@ extern "C"
     void FASTCALL gfx_draw_sprite_software(rct_drawpixelinfo *dpi, sint32 image_id, sint32 x, sint32 y, uint32 tertiary_colour)
     {
         uint8* palette_pointer = gfx_draw_sprite_get_palette(image_id, tertiary_colour);
+        uint32 palette_key = gfx_draw_sprite_get_palette_key(image_id, tertiary_colour);
         if (image_id & IMAGE_TYPE_REMAP_2_PLUS) {
             image_id |= IMAGE_TYPE_REMAP;
         }
 
-
-        gfx_draw_sprite_palette_set_software(dpi, image_id, x, y, palette_pointer, nullptr);
+        gfx_draw_sprite_palette_set_software_keyed(dpi, image_id, x, y, palette_pointer, nullptr, palette_key);
     }
 
     /*
@@ -418,6 +525,15 @@ extern "C"
     * y (dx)
     */
     void FASTCALL gfx_draw_sprite_palette_set_software(rct_drawpixelinfo *dpi, sint32 image_id, sint32 x, sint32 y, uint8* palette_pointer, uint8* unknown_pointer)
+    {
+        gfx_draw_sprite_palette_set_software_keyed(dpi, image_id, x, y, palette_pointer, unknown_pointer, 0);
+    }
+
+    /**
+     * palette_key identifies the contents of palette_pointer, see gfx_draw_sprite_get_palette_key. If it is
+     * not 0 the sprite is drawn from a copy that already has the palette applied.
+     */
+    static void gfx_draw_sprite_palette_set_software_keyed(rct_drawpixelinfo *dpi, sint32 image_id, sint32 x, sint32 y, uint8* palette_pointer, uint8* unknown_pointer, uint32 palette_key)
     {
         sint32 image_element = image_id & 0x7FFFF;
         sint32 image_type = image_id & 0xE0000000;
@@ -433,7 +549,7 @@ extern "C"
             zoomed_dpi.width = dpi->width >> 1;
             zoomed_dpi.pitch = dpi->pitch;
             zoomed_dpi.zoom_level = dpi->zoom_level - 1;
-            gfx_draw_sprite_palette_set_software(&zoomed_dpi, image_type | (image_element - g1_source->zoomed_offset), x >> 1, y >> 1, palette_pointer, unknown_pointer);
+            gfx_draw_sprite_palette_set_software_keyed(&zoomed_dpi, image_type | (image_element - g1_source->zoomed_offset), x >> 1, y >> 1, palette_pointer, unknown_pointer, palette_key);
             return;
         }
 
@@ -441,6 +557,21 @@ extern "C"
             return;
         }
 
+        // Identifies the palette already applied to g1_source, if any
+        uint32 source_palette_key = 0;
+
+        // Image 0 is temporarily replaced by windows that draw their own bitmaps. The palette key is
+        // only set for remapped images that are not transparent, including those with 2 or 3 colours.
+        if (palette_key != 0 && image_element != 0) {
+            const rct_g1_element *remapped = _spriteCache.GetRemapped(image_element, g1_source, palette_key, palette_pointer);
+            if (remapped != nullptr) {
+                g1_source = (rct_g1_element *)remapped;
+                image_type = IMAGE_TYPE_DEFAULT;
+                palette_pointer = nullptr;
+                source_palette_key = palette_key;
+            }
+        }
+
         //Its used super often so we will define it to a separate variable.
         sint32 zoom_level = dpi->zoom_level;
         sint32 zoom_mask = 0xFFFFFFFF << zoom_level;
@@ -543,6 +674,10 @@ extern "C"
         if (g1_source->flags & G1_FLAG_RLE_COMPRESSION){
             //We have to use a different method to move the source pointer for
             //rle encoded sprites so that will be handled within this function
+            if (zoom_level != 0 && image_element != 0 &&
+                gfx_rle_sprite_to_buffer_zoomed(image_element, g1_source, source_palette_key, dest_pointer, palette_pointer, dpi, image_type, source_start_y, height, source_start_x, width)) {
+                return;
+            }
             gfx_rle_sprite_to_buffer(g1_source->offset, dest_pointer, palette_pointer, dpi, image_type, source_start_y, height, source_start_x, width);
             return;
         }
@@ -619,6 +754,11 @@ extern "C"
         }
     }
 
+    void gfx_invalidate_remapped_sprite(uint32 image_id)
+    {
+        _spriteCache.Invalidate(image_id & 0x7FFFF);
+    }
+
     rct_g1_element * gfx_get_g1_element(sint32 image_id)
     {
         if (image_id < SPR_G2_BEGIN)
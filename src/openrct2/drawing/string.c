@@ -14,6 +14,7 @@
  *****************************************************************************/
 #pragma endregion
 
+#include "../config/Config.h"
 #include "../interface/colour.h"
 #include "../interface/viewport.h"
 #include "../localisation/localisation.h"
@@ -39,32 +40,42 @@ static void ttf_draw_string(rct_drawpixelinfo *dpi, char *buffer, sint32 colour,
 #ifndef NO_TTF
 static bool _ttfInitialised = false;
 
-#define TTF_SURFACE_CACHE_SIZE 256
-#define TTF_GETWIDTH_CACHE_SIZE 1024
+// Number of hash buckets for each cache, entries are chained so this is not a limit
+#define TTF_CACHE_BUCKET_COUNT 1024
+
+// Share of the configured TTF cache budget given to the string width cache
+#define TTF_GETWIDTH_CACHE_BUDGET_DIVISOR 8
 
 typedef struct ttf_cache_entry {
-	SDL_Surface *surface;
+	struct ttf_cache_entry *hashNext;
+	struct ttf_cache_entry *lruPrev;
+	struct ttf_cache_entry *lruNext;
+	uint32 hash;
 	TTF_Font *font;
 	utf8 *text;
-	uint32 lastUseTick;
+	size_t size;
+	union {
+		SDL_Surface *surface;
+		uint32 width;
+	};
 } ttf_cache_entry;
 
-static ttf_cache_entry _ttfSurfaceCache[TTF_SURFACE_CACHE_SIZE] = { 0 };
-static sint32 _ttfSurfaceCacheCount = 0;
-static sint32 _ttfSurfaceCacheHitCount = 0;
-static sint32 _ttfSurfaceCacheMissCount = 0;
-
-typedef struct ttf_getwidth_cache_entry {
-	uint32 width;
-	TTF_Font *font;
-	utf8 *text;
-	uint32 lastUseTick;
-} ttf_getwidth_cache_entry;
-
-static ttf_getwidth_cache_entry _ttfGetWidthCache[TTF_GETWIDTH_CACHE_SIZE] = { 0 };
-static sint32 _ttfGetWidthCacheCount = 0;
-static sint32 _ttfGetWidthCacheHitCount = 0;
-static sint32 _ttfGetWidthCacheMissCount = 0;
+/**
+ * A cache of rendered strings keyed by font and text. Entries are evicted least recently used first
+ * once the total size of the cached data exceeds the budget.
+ */
+typedef struct ttf_cache {
+	ttf_cache_entry *buckets[TTF_CACHE_BUCKET_COUNT];
+	ttf_cache_entry *lruHead;
+	ttf_cache_entry *lruTail;
+	size_t size;
+	size_t budget;
+	ttf_cache_stats stats;
+	void (*dispose_value)(ttf_cache_entry *entry);
+} ttf_cache;
+
+static ttf_cache _ttfSurfaceCache = { 0 };
+static ttf_cache _ttfGetWidthCache = { 0 };
 #endif // NO_TTF
 
 /**
@@ -717,55 +728,115 @@ static uint32 _ttf_surface_cache_hash(TTF_Font *font, const utf8 *text)
 	return hash;
 }
 
-static void _ttf_surface_cache_dispose(ttf_cache_entry *entry)
+static void _ttf_cache_lru_unlink(ttf_cache *cache, ttf_cache_entry *entry)
 {
-	if (entry->surface != NULL) {
-		SDL_FreeSurface(entry->surface);
-		free(entry->text);
-
-		entry->surface = NULL;
-		entry->font = NULL;
-		entry->text = NULL;
+	if (entry->lruPrev != NULL) {
+		entry->lruPrev->lruNext = entry->lruNext;
+	} else {
+		cache->lruHead = entry->lruNext;
+	}
+	if (entry->lruNext != NULL) {
+		entry->lruNext->lruPrev = entry->lruPrev;
+	} else {
+		cache->lruTail = entry->lruPrev;
 	}
+	entry->lruPrev = NULL;
+	entry->lruNext = NULL;
 }
 
-static void _ttf_surface_cache_dispose_all()
+static void _ttf_cache_lru_push_front(ttf_cache *cache, ttf_cache_entry *entry)
 {
-	for (sint32 i = 0; i < TTF_SURFACE_CACHE_SIZE; i++) {
-		_ttf_surface_cache_dispose(&_ttfSurfaceCache[i]);
-		_ttfSurfaceCacheCount--;
+	entry->lruPrev = NULL;
+	entry->lruNext = cache->lruHead;
+	if (cache->lruHead != NULL) {
+		cache->lruHead->lruPrev = entry;
+	} else {
+		cache->lruTail = entry;
 	}
+	cache->lruHead = entry;
 }
 
-SDL_Surface *ttf_surface_cache_get_or_add(TTF_Font *font, const utf8 *text)
+static void _ttf_cache_remove(ttf_cache *cache, ttf_cache_entry *entry)
 {
-	ttf_cache_entry *entry;
+	ttf_cache_entry **link = &cache->buckets[entry->hash % TTF_CACHE_BUCKET_COUNT];
+	while (*link != entry) {
+		link = &(*link)->hashNext;
+	}
+	*link = entry->hashNext;
+	_ttf_cache_lru_unlink(cache, entry);
+
+	cache->size -= entry->size;
+	cache->stats.count--;
+	cache->dispose_value(entry);
+	free(entry->text);
+	free(entry);
+}
 
-	uint32 hash = _ttf_surface_cache_hash(font, text);
-	sint32 index = hash % TTF_SURFACE_CACHE_SIZE;
-	for (sint32 i = 0; i < TTF_SURFACE_CACHE_SIZE; i++) {
-		entry = &_ttfSurfaceCache[index];
-
-		// Check if entry is a hit
-		if (entry->surface == NULL) break;
-		if (entry->font == font && strcmp(entry->text, text) == 0) {
-			_ttfSurfaceCacheHitCount++;
-			entry->lastUseTick = gCurrentDrawCount;
-			return entry->surface;
-		}
+static void _ttf_cache_dispose_all(ttf_cache *cache)
+{
+	while (cache->lruTail != NULL) {
+		_ttf_cache_remove(cache, cache->lruTail);
+	}
+}
 
-		// If entry hasn't been used for a while, replace it
-		if (entry->lastUseTick < gCurrentDrawCount - 64) {
-			break;
+static ttf_cache_entry *_ttf_cache_find(ttf_cache *cache, TTF_Font *font, const utf8 *text, uint32 hash)
+{
+	for (ttf_cache_entry *entry = cache->buckets[hash % TTF_CACHE_BUCKET_COUNT]; entry != NULL; entry = entry->hashNext) {
+		if (entry->hash == hash && entry->font == font && strcmp(entry->text, text) == 0) {
+			// Move to the front so it is the last to be evicted
+			_ttf_cache_lru_unlink(cache, entry);
+			_ttf_cache_lru_push_front(cache, entry);
+			cache->stats.hits++;
+			return entry;
 		}
+	}
+	cache->stats.misses++;
+	return NULL;
+}
 
-		// Check if next entry is a hit
-		if (++index >= TTF_SURFACE_CACHE_SIZE) index = 0;
+/**
+ * Adds a new entry of the given size, evicting the least recently used entries until it fits.
+ * The caller is responsible for setting the entry's value.
+ */
+static ttf_cache_entry *_ttf_cache_add(ttf_cache *cache, TTF_Font *font, const utf8 *text, uint32 hash, size_t valueSize)
+{
+	size_t textSize = strlen(text) + 1;
+	size_t size = sizeof(ttf_cache_entry) + textSize + valueSize;
+	while (cache->lruTail != NULL && cache->size + size > cache->budget) {
+		_ttf_cache_remove(cache, cache->lruTail);
+		cache->stats.evictions++;
 	}
 
-	// Cache miss, replace entry with new surface
-	entry = &_ttfSurfaceCache[index];
-	_ttf_surface_cache_dispose(entry);
+	ttf_cache_entry *entry = malloc(sizeof(ttf_cache_entry));
+	entry->hash = hash;
+	entry->font = font;
+	entry->text = malloc(textSize);
+	memcpy(entry->text, text, textSize);
+	entry->size = size;
+
+	ttf_cache_entry **bucket = &cache->buckets[hash % TTF_CACHE_BUCKET_COUNT];
+	entry->hashNext = *bucket;
+	*bucket = entry;
+	_ttf_cache_lru_push_front(cache, entry);
+
+	cache->size += size;
+	cache->stats.count++;
+	return entry;
+}
+
+static void _ttf_surface_cache_dispose(ttf_cache_entry *entry)
+{
+	SDL_FreeSurface(entry->surface);
+	entry->surface = NULL;
+}
+
+SDL_Surface *ttf_surface_cache_get_or_add(TTF_Font *font, const utf8 *text)
+{
+	uint32 hash = _ttf_surface_cache_hash(font, text);
+	ttf_cache_entry *entry = _ttf_cache_find(&_ttfSurfaceCache, font, text, hash);
+	if (entry != NULL) {
+		return entry->surface;
+	}
 
 	SDL_Color c = { 0, 0, 0, 255 };
 	SDL_Surface *surface = TTF_RenderUTF8_Solid(font, text, c);
@@ -773,79 +844,44 @@ SDL_Surface *ttf_surface_cache_get_or_add(TTF_Font *font, const utf8 *text)
 		return NULL;
 	}
 
-	_ttfSurfaceCacheMissCount++;
-	// printf("CACHE HITS: %d   MISSES: %d)\n", _ttfSurfaceCacheHitCount, _ttfSurfaceCacheMissCount);
-
-	_ttfSurfaceCacheCount++;
+	size_t surfaceSize = sizeof(SDL_Surface) + (size_t)surface->pitch * surface->h;
+	entry = _ttf_cache_add(&_ttfSurfaceCache, font, text, hash, surfaceSize);
 	entry->surface = surface;
-	entry->font = font;
-	entry->text = _strdup(text);
-	entry->lastUseTick = gCurrentDrawCount;
 	return entry->surface;
 }
 
-static void _ttf_getwidth_cache_dispose(ttf_getwidth_cache_entry *entry)
+static void _ttf_getwidth_cache_dispose(ttf_cache_entry *entry)
 {
-	if (entry->text != NULL) {
-		free(entry->text);
-
-		entry->width = 0;
-		entry->font = NULL;
-		entry->text = NULL;
-	}
-}
-
-static void _ttf_getwidth_cache_dispose_all()
-{
-	for (sint32 i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++) {
-		_ttf_getwidth_cache_dispose(&_ttfGetWidthCache[i]);
-		_ttfGetWidthCacheCount--;
-	}
+	entry->width = 0;
 }
 
 static uint32 _ttf_getwidth_cache_get_or_add(TTF_Font *font, const utf8 *text)
 {
-	ttf_getwidth_cache_entry *entry;
-
 	uint32 hash = _ttf_surface_cache_hash(font, text);
-	sint32 index = hash % TTF_GETWIDTH_CACHE_SIZE;
-	for (sint32 i = 0; i < TTF_GETWIDTH_CACHE_SIZE; i++) {
-		entry = &_ttfGetWidthCache[index];
-
-		// Check if entry is a hit
-		if (entry->text == NULL) break;
-		if (entry->font == font && strcmp(entry->text, text) == 0) {
-			_ttfGetWidthCacheHitCount++;
-			entry->lastUseTick = gCurrentDrawCount;
-			return entry->width;
-		}
-
-		// If entry hasn't been used for a while, replace it
-		if (entry->lastUseTick < gCurrentDrawCount - 64) {
-			break;
-		}
-
-		// Check if next entry is a hit
-		if (++index >= TTF_GETWIDTH_CACHE_SIZE) index = 0;
+	ttf_cache_entry *entry = _ttf_cache_find(&_ttfGetWidthCache, font, text, hash);
+	if (entry != NULL) {
+		return entry->width;
 	}
 
-	// Cache miss, replace entry with new width
-	entry = &_ttfGetWidthCache[index];
-	_ttf_getwidth_cache_dispose(entry);
-
 	sint32 width, height;
 	TTF_SizeUTF8(font, text, &width, &height);
 
-	_ttfGetWidthCacheMissCount++;
-
-	_ttfGetWidthCacheCount++;
+	entry = _ttf_cache_add(&_ttfGetWidthCache, font, text, hash, 0);
 	entry->width = width;
-	entry->font = font;
-	entry->text = _strdup(text);
-	entry->lastUseTick = gCurrentDrawCount;
 	return entry->width;
 }
 
+void ttf_get_cache_stats(ttf_cache_stats *surfaceStats, ttf_cache_stats *widthStats)
+{
+	*surfaceStats = _ttfSurfaceCache.stats;
+	surfaceStats->size = (uint32)_ttfSurfaceCache.size;
+	surfaceStats->budget = (uint32)_ttfSurfaceCache.budget;
+
+	*widthStats = _ttfGetWidthCache.stats;
+	widthStats->size = (uint32)_ttfGetWidthCache.size;
+	widthStats->budget = (uint32)_ttfGetWidthCache.budget;
+}
+
 bool ttf_initialise()
 {
 	if (!_ttfInitialised) {
@@ -869,6 +905,12 @@ bool ttf_initialise()
 			}
 		}
 
+		size_t budget = (size_t)max(gConfigFonts.cache_size, 1) * 1024;
+		_ttfSurfaceCache.budget = budget;
+		_ttfSurfaceCache.dispose_value = _ttf_surface_cache_dispose;
+		_ttfGetWidthCache.budget = budget / TTF_GETWIDTH_CACHE_BUDGET_DIVISOR;
+		_ttfGetWidthCache.dispose_value = _ttf_getwidth_cache_dispose;
+
 		_ttfInitialised = true;
 	}
 	return true;
@@ -879,8 +921,8 @@ void ttf_dispose()
 	if (!_ttfInitialised)
 		return;
 
-	_ttf_surface_cache_dispose_all();
-	_ttf_getwidth_cache_dispose_all();
+	_ttf_cache_dispose_all(&_ttfSurfaceCache);
+	_ttf_cache_dispose_all(&_ttfGetWidthCache);
 
 	for (sint32 i = 0; i < 4; i++) {
 		TTFFontDescriptor *fontDesc = &(gCurrentTTFFontSet->size[i]);
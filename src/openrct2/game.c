@@ -957,75 +957,6 @@ void save_game_as()
 	window_loadsave_open(LOADSAVETYPE_SAVE | LOADSAVETYPE_GAME, name);
 }
 
-static sint32 compare_autosave_file_paths (const void * a, const void * b ) {
-	return strcmp(*(char **)a, *(char **)b);
-}
-
-static void limit_autosave_count(const size_t numberOfFilesToKeep)
-{
-	sint32 fileEnumHandle = 0;
-
-	size_t autosavesCount = 0;
-	size_t numAutosavesToDelete = 0;
-
-	file_info fileInfo;
-
-	utf8 filter[MAX_PATH];
-
-	utf8 **autosaveFiles = NULL;
-
-	size_t i=0;
-
-	platform_get_user_directory(filter, "save", sizeof(filter));
-	safe_strcat_path(filter, "autosave_*.sv6", sizeof(filter));
-
-	// At first, count how many autosaves there are
-	fileEnumHandle = platform_enumerate_files_begin(filter);
-	while (platform_enumerate_files_next(fileEnumHandle, &fileInfo)) {
-		autosavesCount++;
-	}
-	platform_enumerate_files_end(fileEnumHandle);
-
-	// If there are fewer autosaves than the number of files to keep we don't need to delete anything
-	if(autosavesCount <= numberOfFilesToKeep) {
-		return;
-	}
-
-	autosaveFiles = (utf8**) malloc(sizeof(utf8*) * autosavesCount);
-
-	fileEnumHandle = platform_enumerate_files_begin(filter);
-	for(i = 0; i < autosavesCount; i++) {
-		autosaveFiles[i] = (utf8*)malloc(sizeof(utf8) * MAX_PATH);
-		memset(autosaveFiles[i], 0, sizeof(utf8) * MAX_PATH);
-
-		if(platform_enumerate_files_next(fileEnumHandle, &fileInfo)) {
-			platform_get_user_directory(autosaveFiles[i], "save", sizeof(utf8) * MAX_PATH);
-			safe_strcat_path(autosaveFiles[i], fileInfo.path, sizeof(utf8) * MAX_PATH);
-		}
-	}
-	platform_enumerate_files_end(fileEnumHandle);
-
-	qsort (autosaveFiles, autosavesCount, sizeof (char*), compare_autosave_file_paths);
-
-	// calculate how many saves we need to delete.
-	numAutosavesToDelete = autosavesCount - numberOfFilesToKeep;
-
-	i=0;
-	while (numAutosavesToDelete > 0) {
-		platform_file_delete(autosaveFiles[i]);
-
-		i++;
-		numAutosavesToDelete--;
-	}
-
-
-	for(i = 0; i < autosavesCount; i++) {
-		free(autosaveFiles[i]);
-	}
-
-	free(autosaveFiles);
-}
-
 void game_autosave()
 {
 	const char * subDirectory = "save";
@@ -1048,8 +979,6 @@ void game_autosave()
 		currentDate.year, currentDate.month, currentDate.day, currentTime.hour, currentTime.minute,currentTime.second,
 		fileExtension);
 
-	limit_autosave_count(NUMBER_OF_AUTOSAVES_TO_KEEP);
-
 	utf8 path[MAX_PATH];
 	utf8 backupPath[MAX_PATH];
 	platform_get_user_directory(path, subDirectory, sizeof(path));
@@ -1059,11 +988,12 @@ void game_autosave()
 	safe_strcat(backupPath, fileExtension, sizeof(backupPath));
 	safe_strcat(backupPath, ".bak", sizeof(backupPath));
 
-	if (platform_file_exists(path)) {
-		platform_file_copy(path, backupPath, true);
-	}
+	utf8 prunePattern[MAX_PATH];
+	platform_get_user_directory(prunePattern, "save", sizeof(prunePattern));
+	safe_strcat_path(prunePattern, "autosave_*.sv6", sizeof(prunePattern));
 
-	scenario_save(path, saveFlags);
+	// The backup, pruning of old autosaves and writing the file all happen on a worker thread
+	scenario_autosave(path, backupPath, prunePattern, NUMBER_OF_AUTOSAVES_TO_KEEP, saveFlags);
 }
 
 /**
@@ -1143,6 +1143,54 @@ static sint32 cc_fix_banner_count(const utf8 **argv, sint32 argc)
 	return 0;
 }
 
+static sint32 cc_dirty_stats(const utf8 **argv, sint32 argc)
+{
+	dirty_region_stats stats;
+	if (!drawing_engine_get_dirty_region_stats(&stats)) {
+		console_writeline_error("The current drawing engine redraws the whole screen every frame.");
+		return 1;
+	}
+
+	sint32 screenArea = gScreenWidth * gScreenHeight;
+	console_printf("Invalidated: %u pixels", stats.invalidated_area);
+	console_printf("Merged: %u pixels", stats.merged_area);
+	console_printf("Redrawn: %u pixels (%d%% of the screen) in %u regions",
+		stats.redrawn_area,
+		screenArea == 0 ? 0 : (sint32)(((uint64)stats.redrawn_area * 100) / screenArea),
+		stats.redrawn_regions);
+	return 0;
+}
+
+static sint32 cc_ttf_stats(const utf8 **argv, sint32 argc)
+{
+#ifndef NO_TTF
+	if (!gUseTrueTypeFont) {
+		console_writeline_error("TrueType fonts are not in use.");
+		return 1;
+	}
+
+	ttf_cache_stats surfaceStats, widthStats;
+	ttf_get_cache_stats(&surfaceStats, &widthStats);
+
+	const char *names[] = { "Surfaces", "Widths" };
+	const ttf_cache_stats *stats[] = { &surfaceStats, &widthStats };
+	for (sint32 i = 0; i < 2; i++) {
+		console_printf("%s: %u entries, %u / %u KiB, %u hits, %u misses, %u evictions",
+			names[i],
+			stats[i]->count,
+			stats[i]->size / 1024,
+			stats[i]->budget / 1024,
+			stats[i]->hits,
+			stats[i]->misses,
+			stats[i]->evictions);
+	}
+	return 0;
+#else
+	console_writeline_error("OpenRCT2 was built without TrueType font support.");
+	return 1;
+#endif // NO_TTF
+}
+
 static sint32 cc_open(const utf8 **argv, sint32 argc) {
 	if (argc > 0) {
 		bool title = (gScreenFlags & SCREEN_FLAGS_TITLE_DEMO) != 0;
@@ -1243,6 +1291,8 @@ console_command console_command_table[] = {
 	{ "twitch", cc_twitch, "Twitch API" },
 	{ "reset_user_strings", cc_reset_user_strings, "Resets all user-defined strings, to fix incorrectly occurring 'Chosen name in use already' errors.", "reset_user_strings" },
 	{ "fix_banner_count", cc_fix_banner_count, "Fixes incorrectly appearing 'Too many banners' error by marking every banner entry without a map element as null.", "fix_banner_count" },
+	{ "dirty_stats", cc_dirty_stats, "Shows how much of the screen was redrawn in the last frame.", "dirty_stats" },
+	{ "ttf_stats", cc_ttf_stats, "Shows the usage of the TrueType text caches.", "ttf_stats" },
 	{ "rides", cc_rides, "Ride management.", "rides <subcommand>" },
 	{ "staff", cc_staff, "Staff management.", "staff <subcommand>"},
 };
@@ -29,6 +29,13 @@
 #include "screenshot.h"
 #include "viewport.h"
 
+// Number of rows rendered at a time by screenshot_render_tiled
+#define SCREENSHOT_BAND_HEIGHT 256
+
+// Size of the off-screen viewport rendered by the benchmark command
+#define SCREENSHOT_BENCHMARK_WIDTH 1920
+#define SCREENSHOT_BENCHMARK_HEIGHT 1080
+
 uint8 gScreenshotCountdown = 0;
 
 /**
@@ -149,6 +156,165 @@ sint32 screenshot_dump_png_32bpp(sint32 width, sint32 height, const void *pixels
 	}
 }
 
+/**
+ * Points the viewport at the given map position and sets the current rotation to match.
+ */
+static void screenshot_centre_viewport(rct_viewport *viewport, sint32 centreX, sint32 centreY, sint32 zoom, sint32 rotation)
+{
+	sint32 x = 0, y = 0;
+	sint32 z = map_element_height(centreX, centreY) & 0xFFFF;
+	switch (rotation) {
+	case 0:
+		x = centreY - centreX;
+		y = ((centreX + centreY) / 2) - z;
+		break;
+	case 1:
+		x = -centreY - centreX;
+		y = ((-centreX + centreY) / 2) - z;
+		break;
+	case 2:
+		x = -centreY + centreX;
+		y = ((-centreX - centreY) / 2) - z;
+		break;
+	case 3:
+		x = centreY + centreX;
+		y = ((centreX - centreY) / 2) - z;
+		break;
+	}
+
+	viewport->view_x = x - ((viewport->view_width << zoom) / 2);
+	viewport->view_y = y - ((viewport->view_height << zoom) / 2);
+	viewport->zoom = zoom;
+	gCurrentRotation = rotation;
+}
+
+typedef struct screenshot_band {
+	uint8 *bits;
+	sint32 height;
+} screenshot_band;
+
+typedef struct screenshot_encoder {
+	image_io_png_stream *stream;
+	sint32 width;
+	sint32 numBands;
+	screenshot_band bands[2];
+	SDL_sem *bandsFree;
+	SDL_sem *bandsRendered;
+	bool failed;
+} screenshot_encoder;
+
+static void screenshot_render_band(rct_viewport *viewport, screenshot_band *band, sint32 top)
+{
+	rct_drawpixelinfo dpi;
+	dpi.x = 0;
+	dpi.y = top;
+	dpi.width = viewport->width;
+	dpi.height = band->height;
+	dpi.pitch = 0;
+	dpi.zoom_level = 0;
+	dpi.bits = band->bits;
+
+	memset(band->bits, 0, (size_t)dpi.width * dpi.height);
+	viewport_render(&dpi, viewport, 0, top, viewport->width, top + band->height);
+}
+
+static sint32 screenshot_encoder_thread(void *ptr)
+{
+	screenshot_encoder *encoder = (screenshot_encoder*)ptr;
+	for (sint32 i = 0; i < encoder->numBands; i++) {
+		SDL_SemWait(encoder->bandsRendered);
+
+		// Keep consuming bands after a failure so the render loop never blocks
+		screenshot_band *band = &encoder->bands[i & 1];
+		if (!encoder->failed && !image_io_png_stream_write_rows(encoder->stream, band->bits, band->height, encoder->width)) {
+			encoder->failed = true;
+		}
+
+		SDL_SemPost(encoder->bandsFree);
+	}
+	return 0;
+}
+
+/**
+ * Renders the viewport to a PNG a band of rows at a time, so only a band's worth of pixels is held
+ * in memory regardless of the output size. The paint code is not re-entrant so bands are always
+ * rendered on the calling thread, but when threaded is set the PNG compression of one band runs on
+ * a worker thread while the next band is rendered.
+ */
+bool screenshot_render_tiled(rct_viewport *viewport, const utf8 *path, bool threaded)
+{
+	sint32 width = viewport->width;
+	sint32 height = viewport->height;
+
+	rct_palette renderedPalette;
+	screenshot_get_rendered_palette(&renderedPalette);
+
+	image_io_png_stream *stream = image_io_png_stream_open(path, width, height, &renderedPalette);
+	if (stream == NULL) {
+		return false;
+	}
+
+	screenshot_encoder encoder = { 0 };
+	encoder.stream = stream;
+	encoder.width = width;
+	encoder.numBands = (height + SCREENSHOT_BAND_HEIGHT - 1) / SCREENSHOT_BAND_HEIGHT;
+	for (sint32 i = 0; i < 2; i++) {
+		encoder.bands[i].bits = malloc((size_t)width * SCREENSHOT_BAND_HEIGHT);
+	}
+	if (encoder.bands[0].bits == NULL || encoder.bands[1].bits == NULL) {
+		free(encoder.bands[0].bits);
+		free(encoder.bands[1].bits);
+		image_io_png_stream_close(stream);
+		return false;
+	}
+
+	SDL_Thread *thread = NULL;
+	if (threaded) {
+		encoder.bandsFree = SDL_CreateSemaphore(2);
+		encoder.bandsRendered = SDL_CreateSemaphore(0);
+		if (encoder.bandsFree != NULL && encoder.bandsRendered != NULL) {
+			thread = SDL_CreateThread(screenshot_encoder_thread, "screenshot_encoder", &encoder);
+		}
+		if (thread == NULL) {
+			log_warning("Unable to create screenshot encoder thread, encoding on the main thread.");
+		}
+	}
+
+	for (sint32 i = 0; i < encoder.numBands; i++) {
+		sint32 top = i * SCREENSHOT_BAND_HEIGHT;
+		screenshot_band *band = &encoder.bands[i & 1];
+
+		if (thread != NULL) {
+			SDL_SemWait(encoder.bandsFree);
+		}
+		band->height = min(SCREENSHOT_BAND_HEIGHT, height - top);
+		screenshot_render_band(viewport, band, top);
+
+		if (thread != NULL) {
+			SDL_SemPost(encoder.bandsRendered);
+		} else if (!image_io_png_stream_write_rows(stream, band->bits, band->height, width)) {
+			encoder.failed = true;
+			break;
+		}
+	}
+
+	if (thread != NULL) {
+		SDL_WaitThread(thread, NULL);
+	}
+	if (encoder.bandsFree != NULL) {
+		SDL_DestroySemaphore(encoder.bandsFree);
+	}
+	if (encoder.bandsRendered != NULL) {
+		SDL_DestroySemaphore(encoder.bandsRendered);
+	}
+	for (sint32 i = 0; i < 2; i++) {
+		free(encoder.bands[i].bits);
+	}
+
+	bool result = image_io_png_stream_close(stream);
+	return result && !encoder.failed;
+}
+
 void screenshot_giant()
 {
 	sint32 originalRotation = get_current_rotation();
@@ -180,46 +346,11 @@ void screenshot_giant()
 	sint32 centreX = (mapSize / 2) * 32 + 16;
 	sint32 centreY = (mapSize / 2) * 32 + 16;
 
-	sint32 x = 0, y = 0;
-	sint32 z = map_element_height(centreX, centreY) & 0xFFFF;
-	switch (rotation) {
-	case 0:
-		x = centreY - centreX;
-		y = ((centreX + centreY) / 2) - z;
-		break;
-	case 1:
-		x = -centreY - centreX;
-		y = ((-centreX + centreY) / 2) - z;
-		break;
-	case 2:
-		x = -centreY + centreX;
-		y = ((-centreX - centreY) / 2) - z;
-		break;
-	case 3:
-		x = centreY + centreX;
-		y = ((centreX - centreY) / 2) - z;
-		break;
-	}
-
-	viewport.view_x = x - ((viewport.view_width << zoom) / 2);
-	viewport.view_y = y - ((viewport.view_height << zoom) / 2);
-	viewport.zoom = zoom;
-	gCurrentRotation = rotation;
+	screenshot_centre_viewport(&viewport, centreX, centreY, zoom, rotation);
 
 	// Ensure sprites appear regardless of rotation
 	reset_all_sprite_quadrant_placements();
 
-	rct_drawpixelinfo dpi;
-	dpi.x = 0;
-	dpi.y = 0;
-	dpi.width = resolutionWidth;
-	dpi.height = resolutionHeight;
-	dpi.pitch = 0;
-	dpi.zoom_level = 0;
-	dpi.bits = malloc(dpi.width * dpi.height);
-
-	viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
-
 	// Get a free screenshot path
 	char path[MAX_PATH];
 	sint32 index;
@@ -229,12 +360,11 @@ void screenshot_giant()
 		return;
 	}
 
-	rct_palette renderedPalette;
-	screenshot_get_rendered_palette(&renderedPalette);
-
-	image_io_png_write(&dpi, &renderedPalette, path);
-
-	free(dpi.bits);
+	if (!screenshot_render_tiled(&viewport, path, true)) {
+		log_error("Giant screenshot failed, unable to write %s.", path);
+		window_error_open(STR_SCREENSHOT_FAILED, STR_NONE);
+		return;
+	}
 
 	// Show user that screenshot saved successfully
 	set_format_arg(0, rct_string_id, STR_STRING);
@@ -242,7 +372,7 @@ void screenshot_giant()
 	window_error_open(STR_SCREENSHOT_SAVED_AS, STR_NONE);
 }
 
-sint32 cmdline_for_screenshot(const char **argv, sint32 argc)
+sint32 cmdline_for_screenshot(const char **argv, sint32 argc, bool threaded)
 {
 	bool giantScreenshot = argc == 5 && _stricmp(argv[2], "giant") == 0;
 	if (argc != 4 && argc != 8 && !giantScreenshot) {
@@ -320,31 +450,7 @@ sint32 cmdline_for_screenshot(const char **argv, sint32 argc)
 			if (centreMapY)
 				customY = (mapSize / 2) * 32 + 16;
 
-			sint32 x = 0, y = 0;
-			sint32 z = map_element_height(customX, customY) & 0xFFFF;
-			switch (customRotation) {
-			case 0:
-				x = customY - customX;
-				y = ((customX + customY) / 2) - z;
-				break;
-			case 1:
-				x = -customY - customX;
-				y = ((-customX + customY) / 2) - z;
-				break;
-			case 2:
-				x = -customY + customX;
-				y = ((-customX - customY) / 2) - z;
-				break;
-			case 3:
-				x = customY + customX;
-				y = ((customX - customY) / 2) - z;
-				break;
-			}
-
-			viewport.view_x = x - ((viewport.view_width << customZoom) / 2);
-			viewport.view_y = y - ((viewport.view_height << customZoom) / 2);
-			viewport.zoom = customZoom;
-			gCurrentRotation = customRotation;
+			screenshot_centre_viewport(&viewport, customX, customY, customZoom, customRotation);
 		} else {
 			viewport.view_x = gSavedViewX - (viewport.view_width / 2);
 			viewport.view_y = gSavedViewY - (viewport.view_height / 2);
@@ -355,21 +461,123 @@ sint32 cmdline_for_screenshot(const char **argv, sint32 argc)
 		// Ensure sprites appear regardless of rotation
 		reset_all_sprite_quadrant_placements();
 
+		if (!screenshot_render_tiled(&viewport, outputPath, threaded)) {
+			log_error("Unable to write screenshot to %s.", outputPath);
+		}
+
+		drawing_engine_dispose();
+	}
+	openrct2_dispose();
+	return 1;
+}
+
+static double screenshot_ticks_to_ms(uint64 ticks)
+{
+	return (ticks * 1000.0) / SDL_GetPerformanceFrequency();
+}
+
+sint32 cmdline_for_render_benchmark(const char **argv, sint32 argc)
+{
+	if (argc != 1 && argc != 2) {
+		printf("Usage: openrct2 screenshot benchmark <file> [<iterations>]\n");
+		return -1;
+	}
+
+	const char *inputPath = argv[0];
+	sint32 iterations = 10;
+	if (argc == 2) {
+		iterations = max(1, atoi(argv[1]));
+	}
+
+	gOpenRCT2Headless = true;
+	if (openrct2_initialise()) {
+		drawing_engine_init();
+		if (!rct2_open_file(inputPath)) {
+			log_error("Unable to open %s.", inputPath);
+			drawing_engine_dispose();
+			openrct2_dispose();
+			return -1;
+		}
+
+		gIntroState = INTRO_STATE_NONE;
+		gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+		rct_viewport viewport;
+		viewport.x = 0;
+		viewport.y = 0;
+		viewport.width = SCREENSHOT_BENCHMARK_WIDTH;
+		viewport.height = SCREENSHOT_BENCHMARK_HEIGHT;
+		viewport.view_width = viewport.width;
+		viewport.view_height = viewport.height;
+		viewport.var_11 = 0;
+		viewport.flags = 0;
+
 		rct_drawpixelinfo dpi;
 		dpi.x = 0;
 		dpi.y = 0;
-		dpi.width = resolutionWidth;
-		dpi.height = resolutionHeight;
+		dpi.width = viewport.width;
+		dpi.height = viewport.height;
 		dpi.pitch = 0;
 		dpi.zoom_level = 0;
 		dpi.bits = malloc(dpi.width * dpi.height);
 
-		viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
-
-		rct_palette renderedPalette;
-		screenshot_get_rendered_palette(&renderedPalette);
-
-		image_io_png_write(&dpi, &renderedPalette, outputPath);
+		// Centre of the map and the centre of each quarter
+		sint32 mapSize = gMapSize * 32;
+		const rct_xy32 positions[] = {
+			{ mapSize / 2,     mapSize / 2     },
+			{ mapSize / 4,     mapSize / 4     },
+			{ mapSize * 3 / 4, mapSize / 4     },
+			{ mapSize / 4,     mapSize * 3 / 4 },
+			{ mapSize * 3 / 4, mapSize * 3 / 4 },
+		};
+
+		viewport_paint_timings total = { 0 };
+		uint64 totalTicks = 0;
+		sint32 totalFrames = 0;
+
+		printf("Rendering %d x %d, %d iterations per view\n", viewport.width, viewport.height, iterations);
+		printf("zoom rotation  frame ms  generate ms  arrange ms  draw ms  columns\n");
+		for (sint32 zoom = 0; zoom < 4; zoom++) {
+			for (sint32 rotation = 0; rotation < 4; rotation++) {
+				viewport_paint_timings timings = { 0 };
+				uint64 ticks = 0;
+				sint32 frames = 0;
+
+				gViewportPaintTimings = &timings;
+				for (size_t i = 0; i < countof(positions); i++) {
+					screenshot_centre_viewport(&viewport, positions[i].x, positions[i].y, zoom, rotation);
+					reset_all_sprite_quadrant_placements();
+
+					for (sint32 j = 0; j < iterations; j++) {
+						uint64 start = SDL_GetPerformanceCounter();
+						viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height);
+						ticks += SDL_GetPerformanceCounter() - start;
+						frames++;
+					}
+				}
+				gViewportPaintTimings = NULL;
+
+				printf("%4d %8d  %8.3f  %11.3f  %10.3f  %7.3f  %7u\n", zoom, rotation,
+					screenshot_ticks_to_ms(ticks) / frames,
+					screenshot_ticks_to_ms(timings.generate) / frames,
+					screenshot_ticks_to_ms(timings.arrange) / frames,
+					screenshot_ticks_to_ms(timings.draw) / frames,
+					timings.columns / frames);
+
+				total.generate += timings.generate;
+				total.arrange += timings.arrange;
+				total.draw += timings.draw;
+				total.columns += timings.columns;
+				totalTicks += ticks;
+				totalFrames += frames;
+			}
+		}
+		printf(" all      all  %8.3f  %11.3f  %10.3f  %7.3f  %7u\n",
+			screenshot_ticks_to_ms(totalTicks) / totalFrames,
+			screenshot_ticks_to_ms(total.generate) / totalFrames,
+			screenshot_ticks_to_ms(total.arrange) / totalFrames,
+			screenshot_ticks_to_ms(total.draw) / totalFrames,
+			total.columns / totalFrames);
 
 		free(dpi.bits);
 		drawing_engine_dispose();
@@ -18,6 +18,7 @@
 #define _SCREENSHOT_H_
 
 #include "../drawing/drawing.h"
+#include "viewport.h"
 
 extern uint8 gScreenshotCountdown;
 
@@ -26,7 +27,9 @@ sint32 screenshot_dump();
 sint32 screenshot_dump_png(rct_drawpixelinfo *dpi);
 sint32 screenshot_dump_png_32bpp(sint32 width, sint32 height, const void *pixels);
 
+bool screenshot_render_tiled(rct_viewport *viewport, const utf8 *path, bool threaded);
 void screenshot_giant();
-sint32 cmdline_for_screenshot(const char **argv, sint32 argc);
+sint32 cmdline_for_screenshot(const char **argv, sint32 argc, bool threaded);
+sint32 cmdline_for_render_benchmark(const char **argv, sint32 argc);
 
 #endif
@@ -52,6 +52,8 @@ sint16 gSavedViewY;
 uint8 gSavedViewZoom;
 uint8 gSavedViewRotation;
 
+viewport_paint_timings *gViewportPaintTimings = NULL;
+
 #ifdef NO_RCT2
 paint_entry *gNextFreePaintStruct;
 uint8 gCurrentRotation;
@@ -69,6 +71,28 @@ static sint16 _interactionMapY;
 static uint16 _unk9AC154;
 static sint16 _unk9ABDAE;
 
+// Width of the area painted for mouse picking in view coordinates, at every zoom level
+#define HIT_TEST_COLUMN_WIDTH 32
+// Height of the area painted for mouse picking in screen pixels, shifted by the zoom level
+#define HIT_TEST_COLUMN_HEIGHT 128
+
+/**
+ * The arranged paint structs of the last area painted for mouse picking. Picking at another point
+ * within the same column only has to hit test the images again, until something is invalidated or
+ * redrawn within the column.
+ */
+typedef struct hit_test_cache {
+	bool valid;
+	uint8 zoom;
+	uint8 rotation;
+	uint32 viewFlags;
+	rct_drawpixelinfo dpi;
+	paint_struct ps;
+} hit_test_cache;
+
+static hit_test_cache _hitTestCache;
+static paint_entry _hitTestPaintStructs[4000];
+
 static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags);
 static void viewport_paint_weather_gloom(rct_drawpixelinfo * dpi);
 
@@ -99,6 +123,7 @@ void viewport_init_all()
 	gMapSelectFlags = 0;
 	gStaffDrawPatrolAreas = 0xFFFF;
 	textinput_cancel();
+	viewport_hit_test_cache_clear();
 }
 
 /**
@@ -694,6 +719,9 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
 	y >>= viewport->zoom;
 	y += viewport->y;
 
+	// Whatever is redrawn may have changed since it was painted for mouse picking
+	viewport_hit_test_cache_invalidate(left, top, right, bottom);
+
 	rct_drawpixelinfo dpi1;
 	dpi1.bits = dpi->bits + (x - dpi->x) + ((y - dpi->y) * (dpi->width + dpi->pitch));
 	dpi1.x = left;
@@ -726,6 +754,16 @@ void viewport_paint(rct_viewport* viewport, rct_drawpixelinfo* dpi, sint16 left,
 	}
 }
 
+/**
+ * Adds the ticks elapsed since start to total and returns the current tick count.
+ */
+static uint64 viewport_paint_timings_lap(uint64 *total, uint64 start)
+{
+	uint64 now = SDL_GetPerformanceCounter();
+	*total += now - start;
+	return now;
+}
+
 static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
 {
 	gCurrentViewportFlags = viewFlags;
@@ -737,10 +775,28 @@ static void viewport_paint_column(rct_drawpixelinfo * dpi, uint32 viewFlags)
 		}
 		gfx_clear(dpi, colour);
 	}
+	viewport_paint_timings *timings = gViewportPaintTimings;
+	uint64 ticks = 0;
+	if (timings != NULL) {
+		timings->columns++;
+		ticks = SDL_GetPerformanceCounter();
+	}
+
 	paint_init(dpi);
 	paint_generate_structs(dpi);
+	if (timings != NULL) {
+		ticks = viewport_paint_timings_lap(&timings->generate, ticks);
+	}
+
 	paint_struct ps = paint_arrange_structs();
+	if (timings != NULL) {
+		ticks = viewport_paint_timings_lap(&timings->arrange, ticks);
+	}
+
 	paint_draw_structs(dpi, &ps, viewFlags);
+	if (timings != NULL) {
+		viewport_paint_timings_lap(&timings->draw, ticks);
+	}
 
 	if (gConfigGeneral.render_weather_gloom &&
 		!gTrackDesignSaveMode &&
@@ -1340,6 +1396,80 @@ static void sub_68862C(rct_drawpixelinfo * dpi, paint_struct * ps)
 	}
 }
 
+static bool viewport_hit_test_cache_contains(sint32 x, sint32 y)
+{
+	const rct_drawpixelinfo *dpi = &_hitTestCache.dpi;
+	return x >= dpi->x && x < dpi->x + dpi->width &&
+		y >= dpi->y && y < dpi->y + dpi->height;
+}
+
+/**
+ * Marks the paint structs kept for mouse picking as out of date if they cover any of the given
+ * area, in view coordinates. Unlike viewport_invalidate, this must be called for every change to
+ * the map or sprites regardless of the zoom levels being invalidated.
+ */
+void viewport_hit_test_cache_invalidate(sint32 left, sint32 top, sint32 right, sint32 bottom)
+{
+	if (!_hitTestCache.valid)
+		return;
+
+	const rct_drawpixelinfo *dpi = &_hitTestCache.dpi;
+	if (right > dpi->x && left < dpi->x + dpi->width &&
+		bottom > dpi->y && top < dpi->y + dpi->height
+	) {
+		_hitTestCache.valid = false;
+	}
+}
+
+/**
+ * Discards the paint structs kept for mouse picking. They point at map elements and sprites, so
+ * this must be called whenever those are moved in memory or removed.
+ */
+void viewport_hit_test_cache_clear()
+{
+	_hitTestCache.valid = false;
+}
+
+/**
+ * Returns the arranged paint structs for the column of the viewport containing the given view
+ * coordinates, repainting the column only if the previous paint structs can not be reused.
+ */
+static paint_struct *viewport_hit_test_get_paint_structs(rct_viewport *viewport, sint32 x, sint32 y)
+{
+	uint8 rotation = get_current_rotation();
+	if (_hitTestCache.valid &&
+		_hitTestCache.zoom == viewport->zoom &&
+		_hitTestCache.rotation == rotation &&
+		_hitTestCache.viewFlags == viewport->flags &&
+		viewport_hit_test_cache_contains(x, y)
+	) {
+		return &_hitTestCache.ps;
+	}
+
+	sint32 columnHeight = HIT_TEST_COLUMN_HEIGHT << viewport->zoom;
+	rct_drawpixelinfo *dpi = &_hitTestCache.dpi;
+	dpi->bits = NULL;
+	dpi->x = floor2(x, HIT_TEST_COLUMN_WIDTH);
+	dpi->y = floor2(y, columnHeight);
+	dpi->width = HIT_TEST_COLUMN_WIDTH;
+	dpi->height = columnHeight;
+	dpi->pitch = 0;
+	dpi->zoom_level = viewport->zoom;
+
+	uint32 preserveViewportFlags = gCurrentViewportFlags;
+	gCurrentViewportFlags = viewport->flags;
+	paint_init_buffer(dpi, _hitTestPaintStructs, countof(_hitTestPaintStructs));
+	paint_generate_structs(dpi);
+	_hitTestCache.ps = paint_arrange_structs();
+	gCurrentViewportFlags = preserveViewportFlags;
+
+	_hitTestCache.zoom = viewport->zoom;
+	_hitTestCache.rotation = rotation;
+	_hitTestCache.viewFlags = viewport->flags;
+	_hitTestCache.valid = true;
+	return &_hitTestCache.ps;
+}
+
 /**
  *
  *  rct2: 0x00685ADC
@@ -1379,10 +1509,8 @@ void get_map_coordinates_from_pos(sint32 screenX, sint32 screenY, sint32 flags,
 			dpi->zoom_level = _viewportDpi1.zoom_level;
 			dpi->x = _viewportDpi1.x;
 			dpi->width = 1;
-			paint_init(dpi);
-			paint_generate_structs(dpi);
-			paint_struct ps = paint_arrange_structs();
-			sub_68862C(dpi, &ps);
+			paint_struct *ps = viewport_hit_test_get_paint_structs(myviewport, screenX, screenY);
+			sub_68862C(dpi, ps);
 		}
 		if (viewport != NULL) *viewport = myviewport;
 	}
@@ -1397,6 +1525,9 @@ void get_map_coordinates_from_pos(sint32 screenX, sint32 screenY, sint32 flags,
  */
 void viewport_invalidate(rct_viewport *viewport, sint32 left, sint32 top, sint32 right, sint32 bottom)
 {
+	// Also applies to viewports that are not visible, the map may have changed underneath
+	viewport_hit_test_cache_invalidate(left, top, right, bottom);
+
 	// if unknown viewport visibility, use the containing window to discover the status
 	if (viewport->visibility == VC_UNKNOWN)
 	{
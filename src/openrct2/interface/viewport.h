@@ -87,6 +87,16 @@ typedef struct viewport_interaction_info {
 	};
 } viewport_interaction_info;
 
+/**
+ * Accumulated time spent in each phase of painting a viewport column, in performance counter ticks.
+ */
+typedef struct viewport_paint_timings {
+	uint64 generate;
+	uint64 arrange;
+	uint64 draw;
+	uint32 columns;
+} viewport_paint_timings;
+
 #define MAX_VIEWPORT_COUNT WINDOW_LIMIT_MAX
 
 /**
@@ -105,6 +115,9 @@ extern sint16 gSavedViewY;
 extern uint8 gSavedViewZoom;
 extern uint8 gSavedViewRotation;
 
+// When set, viewport_paint adds the time spent in each paint phase to these timings
+extern viewport_paint_timings *gViewportPaintTimings;
+
 #ifdef NO_RCT2
 extern paint_entry *gNextFreePaintStruct;
 extern uint8 gCurrentRotation;
@@ -153,6 +166,8 @@ void viewport_interaction_remove_park_entrance(rct_map_element *mapElement, sint
 void sub_68B2B7(sint32 x, sint32 y);
 
 void viewport_invalidate(rct_viewport *viewport, sint32 left, sint32 top, sint32 right, sint32 bottom);
+void viewport_hit_test_cache_invalidate(sint32 left, sint32 top, sint32 right, sint32 bottom);
+void viewport_hit_test_cache_clear();
 
 void screen_get_map_xy(sint32 screenX, sint32 screenY, sint16 *x, sint16 *y, rct_viewport **viewport);
 void screen_get_map_xy_with_z(sint16 screenX, sint16 screenY, sint16 z, sint16 *mapX, sint16 *mapY);
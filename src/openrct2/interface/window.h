@@ -739,6 +739,8 @@ void window_new_ride_init_vars();
 void window_new_ride_focus(ride_list_item rideItem);
 
 void window_map_reset();
+void window_map_invalidate_tile(sint32 x, sint32 y);
+void window_map_invalidate_sprites();
 void window_map_tooltip_update_visibility();
 
 void window_staff_list_init_vars();
@@ -17,6 +17,7 @@
 #include "../config/Config.h"
 #include "../util/util.h"
 #include "currency.h"
+#include "localisation.h"
 #include "string_ids.h"
 
 currency_descriptor CurrencyDescriptors[CURRENCY_END] = {
@@ -44,4 +45,5 @@ void currency_load_custom_currency_config()
 	CurrencyDescriptors[CURRENCY_CUSTOM].rate = gConfigGeneral.custom_currency_rate;
 	CurrencyDescriptors[CURRENCY_CUSTOM].affix_unicode = gConfigGeneral.custom_currency_affix;
 	safe_strcpy(CurrencyDescriptors[CURRENCY_CUSTOM].symbol_unicode, gConfigGeneral.custom_currency_symbol, CURRENCY_SYMBOL_MAX_SIZE);
+	format_string_cache_invalidate();
 }
@@ -124,6 +124,7 @@ void language_close_all()
     SafeDelete(_languageFallback);
     SafeDelete(_languageCurrent);
     gCurrentLanguage = LANGUAGE_UNDEFINED;
+    format_string_cache_invalidate();
 }
 
 constexpr rct_string_id NONSTEX_BASE_STRING_ID = 3463;
@@ -228,6 +229,7 @@ rct_string_id language_allocate_object_string(const utf8 * target)
     rct_string_id stringId = _availableObjectStringIds.top();
     _availableObjectStringIds.pop();
     _languageCurrent->SetString(stringId, target);
+    format_string_cache_invalidate();
     return stringId;
 }
 
@@ -238,6 +240,7 @@ void language_free_object_string(rct_string_id stringId)
         if (_languageCurrent != nullptr)
         {
             _languageCurrent->SetString(stringId, nullptr);
+            format_string_cache_invalidate();
         }
         _availableObjectStringIds.push(stringId);
     }
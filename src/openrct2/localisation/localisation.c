@@ -333,6 +333,129 @@ const rct_string_id DateGameShortMonthNames[MONTH_COUNT] = {
 static void format_string_part_from_raw(char **dest, size_t *size, const char *src, char **args);
 static void format_string_part(char **dest, size_t *size, rct_string_id format, char **args);
 
+#pragma region Format string cache
+
+// Results of format_string are cached by string id and the bytes of the arguments it read
+#define FORMAT_STRING_CACHE_SIZE		1024
+#define FORMAT_STRING_CACHE_HINT_COUNT	4096
+#define FORMAT_STRING_CACHE_MAX_ARGS	32
+#define FORMAT_STRING_CACHE_MAX_LENGTH	128
+
+typedef struct format_string_cache_entry {
+	uint32 generation;
+	rct_string_id format;
+	uint8 args_length;
+	uint8 result_length;
+	uint8 args[FORMAT_STRING_CACHE_MAX_ARGS];
+	utf8 result[FORMAT_STRING_CACHE_MAX_LENGTH];
+} format_string_cache_entry;
+
+static format_string_cache_entry _formatStringCache[FORMAT_STRING_CACHE_SIZE];
+
+// The number of argument bytes last read for a string id, used to pick the cache slot before formatting
+static uint8 _formatStringCacheArgsLengthHint[FORMAT_STRING_CACHE_HINT_COUNT];
+
+// Entries from an older generation are stale, starts at 1 so zeroed entries are never valid
+static uint32 _formatStringCacheGeneration = 1;
+static uint8 _formatStringCacheCurrencyFormat;
+static uint8 _formatStringCacheMeasurementFormat;
+
+// Whether the result of the current format_string call only depends on the argument bytes it read
+static bool _formatResultCacheable;
+
+// The argument cursor of the current format_string call and the furthest it has been moved from
+// its start. Helpers that format their own values use a separate cursor, which is not tracked.
+static char **_formatArgsCursor;
+static const char *_formatArgsStart;
+static size_t _formatArgsRead;
+
+static void format_string_cache_track_args(char **args)
+{
+	if (args == _formatArgsCursor) {
+		size_t read = (size_t)(*args - _formatArgsStart);
+		if (read > _formatArgsRead) {
+			_formatArgsRead = read;
+		}
+	}
+}
+
+/**
+ * Discards all cached format_string results. Must be called whenever a language string or anything
+ * else the formatted output depends on (other than the format arguments) changes.
+ */
+void format_string_cache_invalidate()
+{
+	_formatStringCacheGeneration++;
+}
+
+static uint32 format_string_cache_hash(rct_string_id format, const uint8 *args, size_t argsLength)
+{
+	uint32 hash = 2166136261u ^ format;
+	for (size_t i = 0; i < argsLength; i++) {
+		hash = (hash ^ args[i]) * 16777619u;
+	}
+	return hash;
+}
+
+static format_string_cache_entry *format_string_cache_get_entry(rct_string_id format, const uint8 *args, size_t argsLength)
+{
+	uint32 hash = format_string_cache_hash(format, args, argsLength);
+	return &_formatStringCache[hash % FORMAT_STRING_CACHE_SIZE];
+}
+
+static bool format_string_cache_try_get(utf8 *dest, size_t size, rct_string_id format, const uint8 *args)
+{
+	// Formatting of money and lengths depends on the current config
+	if (_formatStringCacheCurrencyFormat != gConfigGeneral.currency_format ||
+		_formatStringCacheMeasurementFormat != gConfigGeneral.measurement_format
+	) {
+		_formatStringCacheCurrencyFormat = gConfigGeneral.currency_format;
+		_formatStringCacheMeasurementFormat = gConfigGeneral.measurement_format;
+		format_string_cache_invalidate();
+		return false;
+	}
+
+	size_t argsLength = _formatStringCacheArgsLengthHint[format % FORMAT_STRING_CACHE_HINT_COUNT];
+	if (argsLength != 0 && args == NULL) {
+		return false;
+	}
+
+	const format_string_cache_entry *entry = format_string_cache_get_entry(format, args, argsLength);
+	if (entry->generation != _formatStringCacheGeneration ||
+		entry->format != format ||
+		entry->args_length != argsLength ||
+		entry->result_length >= size ||
+		(argsLength != 0 && memcmp(entry->args, args, argsLength) != 0)
+	) {
+		return false;
+	}
+
+	memcpy(dest, entry->result, entry->result_length);
+	dest[entry->result_length] = '\0';
+	return true;
+}
+
+static void format_string_cache_set(rct_string_id format, const uint8 *args, size_t argsLength, const utf8 *result, size_t resultLength)
+{
+	if (argsLength > FORMAT_STRING_CACHE_MAX_ARGS || resultLength >= FORMAT_STRING_CACHE_MAX_LENGTH) {
+		return;
+	}
+
+	_formatStringCacheArgsLengthHint[format % FORMAT_STRING_CACHE_HINT_COUNT] = (uint8)argsLength;
+
+	format_string_cache_entry *entry = format_string_cache_get_entry(format, args, argsLength);
+	entry->generation = _formatStringCacheGeneration;
+	entry->format = format;
+	entry->args_length = (uint8)argsLength;
+	entry->result_length = (uint8)resultLength;
+	if (argsLength != 0) {
+		memcpy(entry->args, args, argsLength);
+	}
+	memcpy(entry->result, result, resultLength);
+}
+
+#pragma endregion
+
 static void format_append_string(char **dest, size_t *size, const utf8 *string) {
 	if ((*size) == 0) return;
 	size_t length = strlen(string);
@@ -963,6 +1086,9 @@ static void format_string_code(uint32 format_code, char **dest, size_t *size, ch
 		value = *((uintptr_t*)*args);
 		*args += sizeof(uintptr_t);
 
+		// The string behind the pointer may change without the arguments changing
+		_formatResultCacheable = false;
+
 		if (value != 0)
 			format_append_string(dest, size, (char*)value);
 		break;
@@ -991,6 +1117,8 @@ static void format_string_code(uint32 format_code, char **dest, size_t *size, ch
 		*args += 2;
 		break;
 	case FORMAT_PUSH16:
+		// Arguments read before moving back still make up the result
+		format_string_cache_track_args(args);
 		*args -= 2;
 		break;
 	case FORMAT_DURATION:
@@ -1095,6 +1223,9 @@ static void format_string_part(utf8 **dest, size_t *size, rct_string_id format,
 		*args += (format & 0xC00) >> 9;
 		format &= ~0xC00;
 
+		// User strings can be renamed at any time
+		_formatResultCacheable = false;
+
 		format_append_string_n(dest, size, &gUserStrings[format * 32], 32);
 		if ((*size) > 0) *(*dest) = '\0';
 	} else if (format < 0xE000) {
@@ -1135,9 +1266,21 @@ void format_string(utf8 *dest, size_t size, rct_string_id format, void *args)
 		return;
 	}
 
+	if (format_string_cache_try_get(dest, size, format, args)) {
+		return;
+	}
+
+	const char *argsStart = (const char*)args;
+	_formatArgsCursor = (char**)&args;
+	_formatArgsStart = argsStart;
+	_formatArgsRead = 0;
+	_formatResultCacheable = true;
+
 	utf8 *end = dest;
 	size_t left = size;
 	format_string_part(&end, &left, format, (char**)&args);
+	format_string_cache_track_args((char**)&args);
+	_formatArgsCursor = NULL;
 	if (left == 0) {
 		// Replace last character with null terminator
 		*(end - 1) = '\0';
@@ -1145,6 +1288,11 @@ void format_string(utf8 *dest, size_t size, rct_string_id format, void *args)
 	} else {
 		// Null terminate
 		*end = '\0';
+
+		// Only cache results that were not cut short by the size of dest
+		if (_formatResultCacheable && left > 1) {
+			format_string_cache_set(format, (const uint8*)argsStart, _formatArgsRead, dest, end - dest);
+		}
 	}
 
 #ifdef DEBUG
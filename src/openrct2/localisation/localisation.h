@@ -33,6 +33,7 @@ void utf8_remove_formatting(utf8* string, bool allowColours);
 void format_string(char *dest, size_t size, rct_string_id format, void *args);
 void format_string_raw(char *dest, size_t size, char *src, void *args);
 void format_string_to_upper(char *dest, size_t size, rct_string_id format, void *args);
+void format_string_cache_invalidate();
 void generate_string_file();
 utf8 *get_string_end(const utf8 *text);
 size_t get_string_size(const utf8 *text);
@@ -17,8 +17,10 @@
 #include <array>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 #include "../core/Console.hpp"
 #include "../core/Memory.hpp"
+#include "../core/Parallel.h"
 #include "FootpathItemObject.h"
 #include "LargeSceneryObject.h"
 #include "Object.h"
@@ -470,33 +472,60 @@ private:
 
     Object * * LoadObjects(const ObjectRepositoryItem * * requiredObjects, size_t * outNewObjectsLoaded)
     {
-        size_t newObjectsLoaded = 0;
-        Object * * loadedObjects = Memory::AllocateArray<Object *>(OBJECT_ENTRY_COUNT);
+        // Find the objects that are not loaded yet, each only once
+        std::vector<const ObjectRepositoryItem *> newObjects;
+        std::unordered_set<const ObjectRepositoryItem *> newObjectSet;
         for (sint32 i = 0; i < OBJECT_ENTRY_COUNT; i++)
         {
-            Object * loadedObject = nullptr;
             const ObjectRepositoryItem * ori = requiredObjects[i];
-            if (ori != nullptr)
+            if (ori != nullptr && ori->LoadedObject == nullptr && newObjectSet.insert(ori).second)
             {
-                loadedObject = ori->LoadedObject;
-                if (loadedObject == nullptr)
-                {
-                    loadedObject = GetOrLoadObject(ori);
-                    if (loadedObject == nullptr)
-                    {
-                        ReportObjectLoadProblem(&ori->ObjectEntry);
-                        Memory::Free(loadedObjects);
-                        return nullptr;
-                    } else {
-                        newObjectsLoaded++;
-                    }
-                }
+                newObjects.push_back(ori);
             }
-            loadedObjects[i] = loadedObject;
+        }
+
+        // Reading and parsing the object files is independent for each object so do it on all
+        // CPUs, Load allocates images and strings so that has to stay on this thread
+        std::vector<Object *> readObjects(newObjects.size());
+        Parallel::For(newObjects.size(), [this, &newObjects, &readObjects](size_t i) -> void
+        {
+            readObjects[i] = _objectRepository->LoadObject(newObjects[i]);
+        });
+
+        bool failed = false;
+        for (size_t i = 0; i < newObjects.size(); i++)
+        {
+            const ObjectRepositoryItem * ori = newObjects[i];
+            Object * loadedObject = readObjects[i];
+            if (failed)
+            {
+                delete loadedObject;
+            }
+            else if (loadedObject == nullptr)
+            {
+                ReportObjectLoadProblem(&ori->ObjectEntry);
+                failed = true;
+            }
+            else
+            {
+                loadedObject->Load();
+                _objectRepository->RegisterLoadedObject(ori, loadedObject);
+            }
+        }
+        if (failed)
+        {
+            return nullptr;
+        }
+
+        Object * * loadedObjects = Memory::AllocateArray<Object *>(OBJECT_ENTRY_COUNT);
+        for (sint32 i = 0; i < OBJECT_ENTRY_COUNT; i++)
+        {
+            const ObjectRepositoryItem * ori = requiredObjects[i];
+            loadedObjects[i] = ori != nullptr ? ori->LoadedObject : nullptr;
         }
         if (outNewObjectsLoaded != nullptr)
         {
-            *outNewObjectsLoaded = newObjectsLoaded;
+            *outNewObjectsLoaded = newObjects.size();
         }
         return loadedObjects;
     }
@@ -23,10 +23,12 @@
 #include "../core/Console.hpp"
 #include "../core/FileScanner.h"
 #include "../core/FileStream.hpp"
+#include "../core/FileWatcher.h"
 #include "../core/Guard.hpp"
 #include "../core/IStream.hpp"
 #include "../core/Memory.hpp"
 #include "../core/MemoryStream.h"
+#include "../core/Parallel.h"
 #include "../core/Path.hpp"
 #include "../core/Stopwatch.hpp"
 #include "../core/String.hpp"
@@ -53,7 +55,7 @@ extern "C"
     #include "../util/util.h"
 }
 
-constexpr uint16 OBJECT_REPOSITORY_VERSION = 10;
+constexpr uint16 OBJECT_REPOSITORY_VERSION = 11;
 
 #pragma pack(push, 1)
 struct ObjectRepositoryHeader
@@ -91,6 +93,16 @@ struct ObjectEntryEqual
 };
 
 using ObjectEntryMap = std::unordered_map<rct_object_entry, size_t, ObjectEntryHash, ObjectEntryEqual>;
+using ObjectPathMap = std::unordered_map<std::string, ObjectRepositoryItem *>;
+
+struct ObjectScanEntry
+{
+    std::string             Path;
+    uint64                  FileSize;
+    uint64                  FileLastModified;
+    ObjectRepositoryItem *  IndexedItem;
+    Object *                ScannedObject;
+};
 
 static void ReportMissingObject(const rct_object_entry * entry);
 
@@ -102,6 +114,8 @@ class ObjectRepository final : public IObjectRepository
     ObjectEntryMap                      _itemMap;
     uint16                              _languageId   = 0;
     sint32                              _numConflicts = 0;
+    std::unique_ptr<FileWatcher>        _watcher;
+    sint32                              _loadedLanguage = -1;
 
 public:
     ObjectRepository(IPlatformEnvironment * env) : _env(env)
@@ -115,15 +129,33 @@ public:
 
     void LoadOrConstruct() override
     {
+        // The editor reloads the objects every time it is opened, the items already loaded can be
+        // kept if no object file has changed since and the names are still in the same language
+        const std::string &rct2Path = _env->GetDirectoryPath(DIRBASE::RCT2, DIRID::OBJECT);
+        const std::string &openrct2Path = _env->GetDirectoryPath(DIRBASE::USER, DIRID::OBJECT);
+        bool changed = FileWatcher::HasChanged(_watcher, { rct2Path, openrct2Path }, gConfigGeneral.watch_directories);
+        if (!changed && _loadedLanguage == gCurrentLanguage)
+        {
+            return;
+        }
+        _loadedLanguage = gCurrentLanguage;
+
         ClearItems();
 
         Query();
-        if (!Load())
+        std::vector<ObjectRepositoryItem> indexedItems;
+        if (!Load(&indexedItems))
         {
+            // Only the object files that have been added or modified since the index was written
+            // need to be scanned again
             _languageId = gCurrentLanguage;
-            Scan();
+            Scan(indexedItems);
             Save();
         }
+        for (auto &item : indexedItems)
+        {
+            FreeItem(&item);
+        }
 
         // SortItems();
     }
@@ -132,7 +164,8 @@ public:
     {
         _languageId = gCurrentLanguage;
         Query();
-        Scan();
+        std::vector<ObjectRepositoryItem> indexedItems;
+        Scan(indexedItems);
         Save();
     }
 
@@ -243,7 +276,7 @@ public:
         }
     }
 
-    void WritePackedObjects(IStream * stream, std::vector<const ObjectRepositoryItem *> &objects) override
+    void WritePackedObjects(SawyerChunkWriter * chunkWriter, std::vector<const ObjectRepositoryItem *> &objects) override
     {
         log_verbose("packing %u objects", objects.size());
         for (const auto &object : objects)
@@ -253,7 +286,7 @@ public:
             log_verbose("exporting object %.8s", object->ObjectEntry.name);
             if (IsObjectCustom(object))
             {
-                WritePackedObject(stream, &object->ObjectEntry);
+                WritePackedObject(chunkWriter, &object->ObjectEntry);
             }
             else
             {
@@ -291,7 +324,12 @@ private:
         Path::QueryDirectory(result, pattern);
     }
 
-    void Scan()
+    /**
+     * Builds the item list from the object directories. Items from a previous index whose file
+     * still has the same size and modification time are reused rather than scanned again. Reused
+     * items are taken from indexedItems, the caller is responsible for freeing the remainder.
+     */
+    void Scan(std::vector<ObjectRepositoryItem> &indexedItems)
     {
         Console::WriteLine("Scanning %lu objects...", _queryDirectoryResult.TotalFiles);
         _numConflicts = 0;
@@ -299,20 +337,35 @@ private:
         auto stopwatch = Stopwatch();
         stopwatch.Start();
 
+        ObjectPathMap indexedItemMap;
+        for (auto &item : indexedItems)
+        {
+            indexedItemMap[item.Path] = &item;
+        }
+
+        std::vector<ObjectScanEntry> entries;
         const std::string &rct2Path = _env->GetDirectoryPath(DIRBASE::RCT2, DIRID::OBJECT);
         const std::string &openrct2Path = _env->GetDirectoryPath(DIRBASE::USER, DIRID::OBJECT);
-        ScanDirectory(rct2Path);
-        ScanDirectory(openrct2Path);
+        QueryScanEntries(rct2Path, indexedItemMap, entries);
+        QueryScanEntries(openrct2Path, indexedItemMap, entries);
+        size_t numScanned = ScanEntries(entries);
 
         stopwatch.Stop();
-        Console::WriteLine("Scanning complete in %.2f seconds.", stopwatch.GetElapsedMilliseconds() / 1000.0f);
+        Console::WriteLine("Scanning complete in %.2f seconds, %u objects scanned, %u reused from index.",
+                           stopwatch.GetElapsedMilliseconds() / 1000.0f,
+                           (uint32)numScanned,
+                           (uint32)(_queryDirectoryResult.TotalFiles - numScanned));
         if (_numConflicts > 0)
         {
             Console::WriteLine("%d object conflicts found.", _numConflicts);
         }
     }
 
-    void ScanDirectory(const std::string &directory)
+    /**
+     * Lists the object files in the given directory along with the indexed item that can be
+     * reused for each file, if any.
+     */
+    void QueryScanEntries(const std::string &directory, ObjectPathMap &indexedItemMap, std::vector<ObjectScanEntry> &entries)
     {
         utf8 pattern[MAX_PATH];
         String::Set(pattern, sizeof(pattern), directory.c_str());
@@ -321,29 +374,107 @@ private:
         IFileScanner * scanner = Path::ScanDirectory(pattern, true);
         while (scanner->Next())
         {
-            const utf8 * enumPath = scanner->GetPath();
-            ScanObject(enumPath);
+            const FileInfo * fileInfo = scanner->GetFileInfo();
+
+            ObjectScanEntry entry;
+            entry.Path = scanner->GetPath();
+            entry.FileSize = fileInfo->Size;
+            entry.FileLastModified = fileInfo->LastModified;
+            entry.IndexedItem = nullptr;
+            entry.ScannedObject = nullptr;
+
+            auto kvp = indexedItemMap.find(entry.Path);
+            if (kvp != indexedItemMap.end())
+            {
+                ObjectRepositoryItem * indexedItem = kvp->second;
+                if (indexedItem->FileSize == entry.FileSize &&
+                    indexedItem->FileLastModified == entry.FileLastModified)
+                {
+                    entry.IndexedItem = indexedItem;
+                }
+            }
+            entries.push_back(entry);
         }
         delete scanner;
     }
 
+    /**
+     * Reads the object files that could not be reused from the index on all CPUs, then adds the
+     * items in directory order so that conflicts resolve the same way as a sequential scan.
+     * Returns the number of files that had to be read.
+     */
+    size_t ScanEntries(std::vector<ObjectScanEntry> &entries)
+    {
+        std::vector<ObjectScanEntry *> entriesToScan;
+        for (auto &entry : entries)
+        {
+            if (entry.IndexedItem == nullptr)
+            {
+                entriesToScan.push_back(&entry);
+            }
+        }
+
+        Parallel::For(entriesToScan.size(), [&entriesToScan](size_t i) -> void
+        {
+            ObjectScanEntry * entry = entriesToScan[i];
+            entry->ScannedObject = ObjectFactory::CreateObjectFromLegacyFile(entry->Path.c_str());
+        });
+
+        for (auto &entry : entries)
+        {
+            ObjectRepositoryItem * indexedItem = entry.IndexedItem;
+            if (indexedItem != nullptr)
+            {
+                ObjectRepositoryItem item = *indexedItem;
+                if (AddItem(&item))
+                {
+                    // Ownership of the strings has moved to the new item
+                    indexedItem->Path = nullptr;
+                    indexedItem->Name = nullptr;
+                    if ((indexedItem->ObjectEntry.flags & 0x0F) == OBJECT_TYPE_SCENERY_SETS)
+                    {
+                        indexedItem->ThemeObjects = nullptr;
+                    }
+                }
+            }
+            else if (entry.ScannedObject != nullptr)
+            {
+                AddScannedObject(entry.ScannedObject, entry.Path.c_str(), entry.FileSize, entry.FileLastModified);
+                delete entry.ScannedObject;
+                entry.ScannedObject = nullptr;
+            }
+        }
+        return entriesToScan.size();
+    }
+
     void ScanObject(const utf8 * path)
     {
         Object * object = ObjectFactory::CreateObjectFromLegacyFile(path);
         if (object != nullptr)
         {
-            ObjectRepositoryItem item = { 0 };
-            item.ObjectEntry = *object->GetObjectEntry();
-            item.Path = String::Duplicate(path);
-            item.Name = String::Duplicate(object->GetName());
-            object->SetRepositoryItem(&item);
-            AddItem(&item);
-
+            // The file details are left as zero so that it is scanned again on the next rebuild
+            AddScannedObject(object, path, 0, 0);
             delete object;
         }
     }
 
-    bool Load()
+    void AddScannedObject(const Object * object, const utf8 * path, uint64 fileSize, uint64 fileLastModified)
+    {
+        ObjectRepositoryItem item = { 0 };
+        item.ObjectEntry = *object->GetObjectEntry();
+        item.Path = String::Duplicate(path);
+        item.Name = String::Duplicate(object->GetName());
+        item.FileSize = fileSize;
+        item.FileLastModified = fileLastModified;
+        object->SetRepositoryItem(&item);
+        AddItem(&item);
+    }
+
+    /**
+     * Loads the index. If the index is out of date but was written by this version in the same
+     * language, its items are returned in outdatedItems so they can be reused by a scan.
+     */
+    bool Load(std::vector<ObjectRepositoryItem> * outdatedItems)
     {
         const std::string &path = _env->GetFilePath(PATHID::CACHE_OBJECTS);
         try
@@ -352,26 +483,41 @@ private:
             auto header = fs.ReadValue<ObjectRepositoryHeader>();
 
             if (header.Version == OBJECT_REPOSITORY_VERSION &&
-                header.LanguageId == gCurrentLanguage &&
-                header.TotalFiles == _queryDirectoryResult.TotalFiles &&
-                header.TotalFileSize == _queryDirectoryResult.TotalFileSize &&
-                header.FileDateModifiedChecksum == _queryDirectoryResult.FileDateModifiedChecksum &&
-                header.PathChecksum == _queryDirectoryResult.PathChecksum)
+                header.LanguageId == gCurrentLanguage)
             {
-                // Header matches, so the index is not out of date
-
                 // Buffer the rest of file into memory to speed up item reading
                 size_t dataSize = (size_t)(fs.GetLength() - fs.GetPosition());
                 void * data = fs.ReadArray<uint8>(dataSize);
                 auto ms = MemoryStream(data, dataSize, MEMORY_ACCESS::READ | MEMORY_ACCESS::OWNER);
 
-                // Read items
-                for (uint32 i = 0; i < header.NumItems; i++)
+                if (header.TotalFiles == _queryDirectoryResult.TotalFiles &&
+                    header.TotalFileSize == _queryDirectoryResult.TotalFileSize &&
+                    header.FileDateModifiedChecksum == _queryDirectoryResult.FileDateModifiedChecksum &&
+                    header.PathChecksum == _queryDirectoryResult.PathChecksum)
+                {
+                    // Header matches, so the index is not out of date
+                    for (uint32 i = 0; i < header.NumItems; i++)
+                    {
+                        ObjectRepositoryItem item = ReadItem(&ms);
+                        AddItem(&item);
+                    }
+                    return true;
+                }
+
+                Console::WriteLine("Object repository is out of date.");
+                try
+                {
+                    outdatedItems->reserve(header.NumItems);
+                    for (uint32 i = 0; i < header.NumItems; i++)
+                    {
+                        outdatedItems->push_back(ReadItem(&ms));
+                    }
+                }
+                catch (const IOException &)
                 {
-                    ObjectRepositoryItem item = ReadItem(&ms);
-                    AddItem(&item);
+                    // Reuse what could be read, the rest will be scanned
                 }
-                return true;
+                return false;
             }
             Console::WriteLine("Object repository is out of date.");
             return false;
@@ -456,6 +602,8 @@ private:
         item.ObjectEntry = stream->ReadValue<rct_object_entry>();
         item.Path = stream->ReadString();
         item.Name = stream->ReadString();
+        item.FileSize = stream->ReadValue<uint64>();
+        item.FileLastModified = stream->ReadValue<uint64>();
 
         switch (item.ObjectEntry.flags & 0x0F) {
         case OBJECT_TYPE_RIDE:
@@ -486,6 +634,8 @@ private:
         stream->WriteValue(item.ObjectEntry);
         stream->WriteString(item.Path);
         stream->WriteString(item.Name);
+        stream->WriteValue<uint64>(item.FileSize);
+        stream->WriteValue<uint64>(item.FileLastModified);
 
         switch (item.ObjectEntry.flags & 0x0F) {
         case OBJECT_TYPE_RIDE:
@@ -668,7 +818,7 @@ private:
         }
     }
 
-    void WritePackedObject(IStream * stream, const rct_object_entry * entry)
+    void WritePackedObject(SawyerChunkWriter * chunkWriter, const rct_object_entry * entry)
     {
         const ObjectRepositoryItem * item = FindObject(entry);
         if (item == nullptr)
@@ -687,9 +837,8 @@ private:
         auto chunk = chunkReader.ReadChunk();
 
         // Write object data to stream
-        auto chunkWriter = SawyerChunkWriter(stream);
-        stream->WriteValue(*entry);
-        chunkWriter.WriteChunk(chunk.get());
+        chunkWriter->WriteValue(*entry);
+        chunkWriter->WriteChunk(chunk.get());
     }
 };
 
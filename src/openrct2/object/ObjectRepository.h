@@ -35,6 +35,7 @@ extern "C"
     interface   IPlatformEnvironment;
     interface   IStream;
     class       Object;
+    class       SawyerChunkWriter;
 #else
     typedef struct Object Object;
 #endif
@@ -45,6 +46,8 @@ typedef struct ObjectRepositoryItem
     rct_object_entry   ObjectEntry;
     utf8 *             Path;
     utf8 *             Name;
+    uint64             FileSize;
+    uint64             FileLastModified;
     Object *           LoadedObject;
     union
     {
@@ -84,7 +87,7 @@ interface IObjectRepository
                                                       size_t dataSize) abstract;
 
     virtual void                            ExportPackedObject(IStream * stream) abstract;
-    virtual void                            WritePackedObjects(IStream * stream, std::vector<const ObjectRepositoryItem *> &objects) abstract;
+    virtual void                            WritePackedObjects(SawyerChunkWriter * chunkWriter, std::vector<const ObjectRepositoryItem *> &objects) abstract;
 };
 
 IObjectRepository * CreateObjectRepository(IPlatformEnvironment * env);
@@ -87,10 +87,19 @@ static uint32 paint_ps_colourify_image(uint32 imageId, uint8 spriteType, uint32
  *  rct2: 0x0068615B
  */
 void paint_init(rct_drawpixelinfo * dpi)
+{
+	paint_init_buffer(dpi, gPaintStructs, 4000);
+}
+
+/**
+ * Same as paint_init but paint structs are allocated from the given buffer instead of
+ * gPaintStructs, so the resulting paint list outlives the next call to paint_init.
+ */
+void paint_init_buffer(rct_drawpixelinfo * dpi, paint_entry * buffer, size_t count)
 {
 	unk_140E9A8 = dpi;
-	gEndOfPaintStructArray = &gPaintStructs[4000 - 1];
-	gNextFreePaintStruct = gPaintStructs;
+	gEndOfPaintStructArray = &buffer[count - 1];
+	gNextFreePaintStruct = buffer;
 	g_ps_F1AD28 = NULL;
 	g_aps_F1AD2C = NULL;
 	for (sint32 i = 0; i < 512; i++) {
@@ -519,6 +519,78 @@ sint32 peep_get_staff_count()
 	return count;
 }
 
+/**
+ * The values shown on the stats and finance pages of the guest window, used to only notify the
+ * window when they change.
+ */
+typedef struct peep_window_values {
+	uint8 happiness;
+	uint8 energy;
+	uint8 hunger;
+	uint8 thirst;
+	uint8 nausea;
+	uint8 bathroom;
+	uint8 intensity;
+	uint8 nausea_tolerance;
+	money32 cash_in_pocket;
+	money32 cash_spent;
+	uint8 no_of_rides;
+	uint8 no_of_food;
+	uint8 no_of_drinks;
+	uint8 no_of_souvenirs;
+} peep_window_values;
+
+static void peep_get_window_values(rct_peep *peep, peep_window_values *values)
+{
+	values->happiness = peep->happiness;
+	values->energy = peep->energy;
+	values->hunger = peep->hunger;
+	values->thirst = peep->thirst;
+	values->nausea = peep->nausea;
+	values->bathroom = peep->bathroom;
+	values->intensity = peep->intensity;
+	values->nausea_tolerance = peep->nausea_tolerance;
+	values->cash_in_pocket = peep->cash_in_pocket;
+	values->cash_spent = peep->cash_spent;
+	values->no_of_rides = peep->no_of_rides;
+	values->no_of_food = peep->no_of_food;
+	values->no_of_drinks = peep->no_of_drinks;
+	values->no_of_souvenirs = peep->no_of_souvenirs;
+}
+
+static void peep_update_window_invalidate_flags(rct_peep *peep, const peep_window_values *oldValues)
+{
+	peep_window_values values;
+	peep_get_window_values(peep, &values);
+
+	if (values.happiness != oldValues->happiness ||
+		values.energy != oldValues->energy ||
+		values.hunger != oldValues->hunger ||
+		values.thirst != oldValues->thirst ||
+		values.nausea != oldValues->nausea ||
+		values.bathroom != oldValues->bathroom ||
+		values.intensity != oldValues->intensity ||
+		values.nausea_tolerance != oldValues->nausea_tolerance
+	) {
+		peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_STATS;
+	}
+
+	// The time in park is shown in minutes
+	if (peep->time_in_park != -1 && ((gScenarioTicks - peep->time_in_park) & 0x7FF) == 0) {
+		peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_STATS;
+	}
+
+	if (values.cash_in_pocket != oldValues->cash_in_pocket ||
+		values.cash_spent != oldValues->cash_spent ||
+		values.no_of_rides != oldValues->no_of_rides ||
+		values.no_of_food != oldValues->no_of_food ||
+		values.no_of_drinks != oldValues->no_of_drinks ||
+		values.no_of_souvenirs != oldValues->no_of_souvenirs
+	) {
+		peep->window_invalidate_flags |= PEEP_INVALIDATE_PEEP_FINANCE;
+	}
+}
+
 /**
  *
  *  rct2: 0x0068F0A9
@@ -528,6 +600,7 @@ void peep_update_all()
 	sint32 i;
 	uint16 spriteIndex;
 	rct_peep* peep;
+	peep_window_values windowValues;
 
 	if (gScreenFlags & (SCREEN_FLAGS_SCENARIO_EDITOR | SCREEN_FLAGS_TRACK_DESIGNER | SCREEN_FLAGS_TRACK_MANAGER))
 		return;
@@ -538,6 +611,8 @@ void peep_update_all()
 		peep = &(get_sprite(spriteIndex)->peep);
 		spriteIndex = peep->next;
 
+		peep_get_window_values(peep, &windowValues);
+
 		if ((uint32)(i & 0x7F) != (gCurrentTicks & 0x7F)) {
 			peep_update(peep);
 		} else {
@@ -547,6 +622,10 @@ void peep_update_all()
 			}
 		}
 
+		if (peep->linked_list_type_offset == SPRITE_LIST_PEEP * 2) {
+			peep_update_window_invalidate_flags(peep, &windowValues);
+		}
+
 		i++;
 	}
 }
@@ -440,6 +440,7 @@ enum PEEP_INVALIDATE {
 	PEEP_INVALIDATE_PEEP_2 = 1 << 2,
 	PEEP_INVALIDATE_PEEP_INVENTORY = 1 << 3,
 	PEEP_INVALIDATE_STAFF_STATS = 1 << 4,
+	PEEP_INVALIDATE_PEEP_FINANCE = 1 << 5,
 };
 
 // Flags used by peep_should_go_on_ride()
@@ -73,19 +73,32 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunk()
                 throw SawyerChunkException("Corrupt chunk size.");
             }
 
-            // Allow 16MiB for chunk data
-            size_t bufferSize = MAX_UNCOMPRESSED_CHUNK_SIZE;
-            uint8 * buffer = Memory::Allocate<uint8>(bufferSize);
+            // Size the buffer from the encoded data rather than allocating the maximum chunk size
+            size_t bufferSize;
+            if (!sawyercoding_get_decode_buffer_size(compressedData.get(), header, &bufferSize))
+            {
+                throw SawyerChunkException("Corrupt chunk data.");
+            }
+            if (bufferSize > MAX_UNCOMPRESSED_CHUNK_SIZE)
+            {
+                throw SawyerChunkException("Chunk data too large.");
+            }
+
+            uint8 * buffer = Memory::Allocate<uint8>(Math::Max<size_t>(bufferSize, 1));
             if (buffer == nullptr)
             {
                 throw Exception("Unable to allocate buffer.");
             }
 
             size_t uncompressedLength = sawyercoding_read_chunk_buffer(buffer, compressedData.get(), header, bufferSize);
-            buffer = Memory::Reallocate(buffer, uncompressedLength);
-            if (buffer == nullptr)
+            if (uncompressedLength != 0 && uncompressedLength < bufferSize)
             {
-                throw Exception("Unable to reallocate buffer.");
+                // Only RLE compressed chunks need more room to decode than the decoded data
+                buffer = Memory::Reallocate(buffer, uncompressedLength);
+                if (buffer == nullptr)
+                {
+                    throw Exception("Unable to reallocate buffer.");
+                }
             }
 
             return std::make_shared<SawyerChunk>((SAWYER_ENCODING)header.encoding, buffer, uncompressedLength);
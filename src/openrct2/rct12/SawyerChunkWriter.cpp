@@ -46,5 +46,11 @@ void SawyerChunkWriter::WriteChunk(const void * src, size_t length, SAWYER_ENCOD
     auto data = std::make_unique<uint8[]>(MAX_COMPRESSED_CHUNK_SIZE);
     size_t dataLength = sawyercoding_write_chunk_buffer(data.get(), (const uint8 *)src, header);
 
-    _stream->Write(data.get(), dataLength);
+    Write(data.get(), dataLength);
+}
+
+void SawyerChunkWriter::Write(const void * src, size_t length)
+{
+    _stream->Write(src, length);
+    _checksum = sawyercoding_update_checksum(_checksum, (const uint8 *)src, length);
 }
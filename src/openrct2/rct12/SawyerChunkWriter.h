@@ -24,16 +24,37 @@ interface IStream;
 
 /**
  * Writes sawyer encoding chunks to a data stream. This can be used to write
- * SC6 and SV6 files.
+ * SC6 and SV6 files. A checksum of every byte written is kept so that it can
+ * be appended to the file without reading it back.
  */
 class SawyerChunkWriter final
 {
 private:
     IStream * const _stream = nullptr;
+    uint32          _checksum = 0;
 
 public:
     SawyerChunkWriter(IStream * stream);
 
+    /**
+     * Gets the checksum of all data written so far.
+     */
+    uint32 GetChecksum() const { return _checksum; }
+
+    /**
+     * Writes the given buffer to the stream without any encoding.
+     */
+    void Write(const void * src, size_t length);
+
+    /**
+     * Writes the given type to the stream without any encoding.
+     */
+    template<typename T>
+    void WriteValue(const T value)
+    {
+        Write(&value, sizeof(T));
+    }
+
     /**
      * Writes a chunk to the stream.
      */
@@ -140,6 +140,7 @@ void rct2_quit()
 void rct2_dispose()
 {
 	object_manager_unload_all_objects();
+	scrolling_text_dispose();
 	gfx_object_check_all_images_freed();
 	gfx_unload_g2();
 	gfx_unload_g1();
@@ -14,14 +14,20 @@
  *****************************************************************************/
 #pragma endregion
 
+#include <algorithm>
+#include <SDL_thread.h>
 #include "../core/Exception.hpp"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
 #include "../core/FileStream.hpp"
 #include "../core/IStream.hpp"
+#include "../core/MemoryStream.h"
 #include "../core/String.hpp"
 #include "../management/award.h"
 #include "../object/Object.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../ParkFile.h"
 #include "../rct12/SawyerChunkWriter.h"
 #include "S6Exporter.h"
 
@@ -54,6 +60,7 @@ extern "C"
 S6Exporter::S6Exporter()
 {
     RemoveTracklessRides = false;
+    NativeFormat = false;
     memset(&_s6, 0, sizeof(_s6));
 }
 
@@ -88,6 +95,12 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
     _s6.header.magic_number = S6_MAGIC_NUMBER;
     _s6.game_version_number = 201028;
 
+    if (NativeFormat)
+    {
+        SaveNative(stream);
+        return;
+    }
+
     auto chunkWriter = SawyerChunkWriter(stream);
 
     // 0: Write header chunk
@@ -103,7 +116,7 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
     if (_s6.header.num_packed_objects > 0)
     {
         IObjectRepository * objRepo = GetObjectRepository();
-        objRepo->WritePackedObjects(stream, ExportObjectsList);
+        objRepo->WritePackedObjects(&chunkWriter, ExportObjectsList);
     }
 
     // 3: Write available objects chunk
@@ -133,17 +146,22 @@ void S6Exporter::Save(IStream * stream, bool isScenario)
         chunkWriter.WriteChunk(&_s6.next_free_map_element_pointer_index, 0x2E8570, SAWYER_ENCODING::RLECOMPRESSED);
     }
 
-    // Determine number of bytes written
-    size_t fileSize = stream->GetLength();
+    // Write the checksum of everything written so far on the end
+    stream->WriteValue(chunkWriter.GetChecksum());
+}
 
-    // Read all written bytes back into a single buffer
-    stream->SetPosition(0);
-    auto data = std::unique_ptr<uint8>(stream->ReadArray<uint8>(fileSize));
-    uint32 checksum = sawyercoding_calculate_checksum(data.get(), fileSize);
+void S6Exporter::SaveNative(IStream * stream)
+{
+    // Packed objects are kept in their SV6 chunk form
+    auto packedObjects = MemoryStream();
+    if (_s6.header.num_packed_objects > 0)
+    {
+        auto chunkWriter = SawyerChunkWriter(&packedObjects);
+        IObjectRepository * objRepo = GetObjectRepository();
+        objRepo->WritePackedObjects(&chunkWriter, ExportObjectsList);
+    }
 
-    // Write the checksum on the end
-    stream->SetPosition(fileSize);
-    stream->WriteValue(checksum);
+    ParkFile::Write(stream, &_s6, packedObjects.GetData(), (size_t)packedObjects.GetLength());
 }
 
 void S6Exporter::Export()
@@ -444,6 +462,7 @@ extern "C"
                 s6exporter->ExportObjectsList = objManager->GetPackableObjects();
             }
             s6exporter->RemoveTracklessRides = true;
+            s6exporter->NativeFormat = gConfigGeneral.save_native_format;
             s6exporter->Export();
             if (flags & S6_SAVE_FLAG_SCENARIO)
             {
@@ -468,4 +487,133 @@ extern "C"
         }
         return result;
     }
+
+    struct BackgroundSave
+    {
+        S6Exporter *    Exporter;
+        bool            IsScenario;
+        std::string     Path;
+        std::string     BackupPath;
+        std::string     PrunePattern;
+        size_t          NumberOfFilesToKeep;
+    };
+
+    static SDL_Thread * _backgroundSaveThread = nullptr;
+
+    /**
+     * Deletes the files matching the given pattern that sort first by path until only the given
+     * number of files remain.
+     */
+    static void LimitFileCount(const std::string &pattern, size_t numberOfFilesToKeep)
+    {
+        std::vector<std::string> paths;
+        IFileScanner * scanner = Path::ScanDirectory(pattern, false);
+        while (scanner->Next())
+        {
+            paths.push_back(scanner->GetPath());
+        }
+        delete scanner;
+
+        if (paths.size() <= numberOfFilesToKeep)
+        {
+            return;
+        }
+
+        std::sort(paths.begin(), paths.end());
+        size_t numFilesToDelete = paths.size() - numberOfFilesToKeep;
+        for (size_t i = 0; i < numFilesToDelete; i++)
+        {
+            File::Delete(paths[i]);
+        }
+    }
+
+    static sint32 BackgroundSaveThread(void * ptr)
+    {
+        auto save = (BackgroundSave *)ptr;
+        try
+        {
+            if (File::Exists(save->Path))
+            {
+                File::Copy(save->Path, save->BackupPath, true);
+            }
+            LimitFileCount(save->PrunePattern, save->NumberOfFilesToKeep);
+
+            if (save->IsScenario)
+            {
+                save->Exporter->SaveScenario(save->Path.c_str());
+            }
+            else
+            {
+                save->Exporter->SaveGame(save->Path.c_str());
+            }
+        }
+        catch (const Exception &)
+        {
+            log_error("Unable to autosave to '%s'", save->Path.c_str());
+        }
+        delete save->Exporter;
+        delete save;
+        return 0;
+    }
+
+    /**
+     * Takes a copy of the game state on the calling thread, then encodes and writes it on a
+     * worker thread so the game does not stall while the file is written. Before writing, an
+     * existing file at path is copied to backupPath and the files matching prunePattern are
+     * limited to numberOfFilesToKeep.
+     * @param flags bit 1: save as scenario
+     */
+    bool scenario_autosave(const utf8 * path, const utf8 * backupPath, const utf8 * prunePattern, size_t numberOfFilesToKeep, sint32 flags)
+    {
+        // Only write one save at a time
+        scenario_autosave_wait();
+
+        map_reorganise_elements();
+        sprite_clear_all_unused();
+
+        viewport_set_saved_view();
+
+        auto s6exporter = new S6Exporter();
+        try
+        {
+            s6exporter->RemoveTracklessRides = true;
+            s6exporter->NativeFormat = gConfigGeneral.save_native_format;
+            s6exporter->Export();
+        }
+        catch (const Exception &)
+        {
+            delete s6exporter;
+            return false;
+        }
+
+        auto save = new BackgroundSave();
+        save->Exporter = s6exporter;
+        save->IsScenario = (flags & S6_SAVE_FLAG_SCENARIO) != 0;
+        save->Path = path;
+        save->BackupPath = backupPath;
+        save->PrunePattern = prunePattern;
+        save->NumberOfFilesToKeep = numberOfFilesToKeep;
+
+        _backgroundSaveThread = SDL_CreateThread(BackgroundSaveThread, "autosave", save);
+        if (_backgroundSaveThread == nullptr)
+        {
+            log_warning("Unable to create autosave thread, saving on the main thread.");
+            BackgroundSaveThread(save);
+        }
+
+        gfx_invalidate_screen();
+        return true;
+    }
+
+    /**
+     * Blocks until the autosave being written in the background, if any, has finished.
+     */
+    void scenario_autosave_wait()
+    {
+        if (_backgroundSaveThread != nullptr)
+        {
+            SDL_WaitThread(_backgroundSaveThread, nullptr);
+            _backgroundSaveThread = nullptr;
+        }
+    }
 }
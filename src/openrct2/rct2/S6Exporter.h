@@ -37,6 +37,7 @@ class S6Exporter final
 {
 public:
     bool RemoveTracklessRides;
+    bool NativeFormat;
     std::vector<const ObjectRepositoryItem *> ExportObjectsList;
 
     S6Exporter();
@@ -51,5 +52,6 @@ private:
     rct_s6_data _s6;
 
     void Save(IStream * stream, bool isScenario);
+    void SaveNative(IStream * stream);
     static uint32 GetLoanHash(money32 initialCash, money32 bankLoan, uint32 maxBankLoan);
 };
@@ -18,11 +18,13 @@
 #include "../core/Exception.hpp"
 #include "../core/FileStream.hpp"
 #include "../core/IStream.hpp"
+#include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../management/award.h"
 #include "../network/network.h"
 #include "../object/ObjectRepository.h"
+#include "../ParkFile.h"
 #include "../ParkImporter.h"
 #include "../rct12/SawyerEncoding.h"
 #include "../rct12/SawyerChunkReader.h"
@@ -107,6 +109,12 @@ public:
 
     void LoadFromStream(IStream * stream, bool isScenario) override
     {
+        if (ParkFile::IsParkFile(stream))
+        {
+            LoadFromParkFile(stream, isScenario);
+            return;
+        }
+
         if (isScenario && !gConfigGeneral.allow_loading_with_incorrect_checksum && !SawyerEncoding::ValidateChecksum(stream))
         {
             throw IOException("Invalid checksum.");
@@ -163,6 +171,32 @@ public:
         }
     }
 
+    /**
+     * Loads a park saved in the native sectioned format. Each section carries its own CRC so
+     * the SV6 checksum is not used.
+     */
+    void LoadFromParkFile(IStream * stream, bool isScenario)
+    {
+        std::vector<uint8> packedObjects;
+        ParkFile::Read(stream, &_s6, PARK_FILE_SECTION::MASK_ALL, &packedObjects);
+
+        if (isScenario && _s6.header.type != S6_TYPE_SCENARIO)
+        {
+            throw Exception("Park is not a scenario.");
+        }
+        else if (!isScenario && _s6.header.type != S6_TYPE_SAVEDGAME)
+        {
+            throw Exception("Park is not a saved game.");
+        }
+
+        IObjectRepository * objectRepo = GetObjectRepository();
+        auto ms = MemoryStream(packedObjects.data(), packedObjects.size());
+        for (uint16 i = 0; i < _s6.header.num_packed_objects; i++)
+        {
+            objectRepo->ExportPackedObject(&ms);
+        }
+    }
+
     bool GetDetails(scenario_index_entry * dst) override
     {
         Memory::Set(dst, 0, sizeof(scenario_index_entry));
@@ -15,13 +15,17 @@
 #pragma endregion
 
 #include <algorithm>
+#include <array>
+#include <cctype>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include "../core/Collections.hpp"
 #include "../core/Console.hpp"
 #include "../core/File.h"
 #include "../core/FileScanner.h"
 #include "../core/FileStream.hpp"
+#include "../core/FileWatcher.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../PlatformEnvironment.h"
@@ -29,6 +33,7 @@
 
 extern "C"
 {
+    #include "../config/Config.h"
     #include "../rct2.h"
     #include "track_design.h"
 }
@@ -53,10 +58,14 @@ struct TrackRepositoryItem
     uint8 RideType = 0;
     std::string ObjectEntry;
     uint32 Flags;
+    uint64 FileSize = 0;
+    uint64 FileLastModified = 0;
 };
 
+using TrackRepositoryItemMap = std::unordered_map<std::string, const TrackRepositoryItem *>;
+
 constexpr uint32 TRACK_REPOSITORY_MAGIC_NUMBER = 0x58444954;
-constexpr uint16 TRACK_REPOSITORY_VERSION = 1;
+constexpr uint16 TRACK_REPOSITORY_VERSION = 2;
 
 enum TRACK_REPO_ITEM_FLAGS
 {
@@ -73,6 +82,12 @@ private:
     std::vector<TrackRepositoryItem> _items;
     QueryDirectoryResult _directoryQueryResult = { 0 };
 
+    // Indices into _items, in item order
+    std::array<std::vector<size_t>, 256> _itemsByRideType;
+    std::unordered_map<std::string, std::vector<size_t>> _itemsByObjectEntry;
+
+    std::unique_ptr<FileWatcher> _watcher;
+
 public:
     TrackDesignRepository(IPlatformEnvironment * env)
     {
@@ -92,11 +107,15 @@ public:
 
     size_t GetCountForObjectEntry(uint8 rideType, const std::string &entry) const override
     {
+        if (entry.empty())
+        {
+            return _itemsByRideType[rideType].size();
+        }
+
         size_t count = 0;
-        for (const auto item : _items)
+        for (size_t index : GetItemIndicesForObjectEntry(entry))
         {
-            if (item.RideType == rideType &&
-                (entry.empty() || String::Equals(item.ObjectEntry, entry, true)))
+            if (_items[index].RideType == rideType)
             {
                 count++;
             }
@@ -106,11 +125,15 @@ public:
 
     size_t GetItemsForObjectEntry(track_design_file_ref * * outRefs, uint8 rideType, const std::string &entry) const override
     {
+        const std::vector<size_t> &indices = entry.empty() ?
+            _itemsByRideType[rideType] :
+            GetItemIndicesForObjectEntry(entry);
+
         std::vector<track_design_file_ref> refs;
-        for (const auto item : _items)
+        for (size_t index : indices)
         {
-            if (item.RideType == rideType &&
-                (entry.empty() || String::Equals(item.ObjectEntry, entry, true)))
+            const TrackRepositoryItem &item = _items[index];
+            if (item.RideType == rideType)
             {
                 track_design_file_ref ref;
                 ref.name = String::Duplicate(GetNameFromTrackPath(item.Path));
@@ -127,19 +150,34 @@ public:
     {
         std::string rct2Directory = _env->GetDirectoryPath(DIRBASE::RCT2, DIRID::TRACK);
         std::string userDirectory = _env->GetDirectoryPath(DIRBASE::USER, DIRID::TRACK);
+        if (!FileWatcher::HasChanged(_watcher, { rct2Directory, userDirectory }, gConfigGeneral.watch_directories))
+        {
+            // Watching is enabled and no track design has been added, removed or modified
+            return;
+        }
 
         _items.clear();
         _directoryQueryResult = { 0 };
         Query(rct2Directory);
         Query(userDirectory);
 
-        if (!Load())
+        std::vector<TrackRepositoryItem> indexedItems;
+        if (!Load(&indexedItems))
         {
-            Scan(rct2Directory, TRIF_READ_ONLY);
-            Scan(userDirectory);
+            // Only the track designs that have been added or modified since the index was written
+            // need to be read again
+            TrackRepositoryItemMap indexedItemMap;
+            for (const auto &item : indexedItems)
+            {
+                indexedItemMap[item.Path] = &item;
+            }
+
+            Scan(rct2Directory, indexedItemMap, TRIF_READ_ONLY);
+            Scan(userDirectory, indexedItemMap);
             SortItems();
             Save();
         }
+        UpdateLookupMaps();
     }
 
     bool Delete(const std::string &path) override
@@ -154,6 +192,7 @@ public:
                 if (File::Delete(path))
                 {
                     _items.erase(_items.begin() + index);
+                    UpdateLookupMaps();
                     result = true;
                 }
             }
@@ -177,6 +216,7 @@ public:
                     item->Name = newName;
                     item->Path = newPath;
                     SortItems();
+                    UpdateLookupMaps();
                     result = newPath;
                 }
             }
@@ -195,6 +235,7 @@ public:
         {
             AddTrack(path);
             SortItems();
+            UpdateLookupMaps();
             result = path;
         }
         return result;
@@ -207,19 +248,33 @@ private:
         Path::QueryDirectory(&_directoryQueryResult, pattern);
     }
 
-    void Scan(const std::string &directory, uint32 flags = 0)
+    void Scan(const std::string &directory, const TrackRepositoryItemMap &indexedItemMap, uint32 flags = 0)
     {
         std::string pattern = Path::Combine(directory, TD_FILE_PATTERN);
         IFileScanner * scanner = Path::ScanDirectory(pattern, true);
         while (scanner->Next())
         {
             const utf8 * path = scanner->GetPath();
-            AddTrack(path, flags);
+            const FileInfo * fileInfo = scanner->GetFileInfo();
+
+            auto kvp = indexedItemMap.find(path);
+            if (kvp != indexedItemMap.end())
+            {
+                const TrackRepositoryItem * indexedItem = kvp->second;
+                if (indexedItem->Flags == flags &&
+                    indexedItem->FileSize == fileInfo->Size &&
+                    indexedItem->FileLastModified == fileInfo->LastModified)
+                {
+                    _items.push_back(*indexedItem);
+                    continue;
+                }
+            }
+            AddTrack(path, flags, fileInfo);
         }
         delete scanner;
     }
 
-    void AddTrack(const std::string path, uint32 flags = 0)
+    void AddTrack(const std::string path, uint32 flags = 0, const FileInfo * fileInfo = nullptr)
     {
         rct_track_td6 * td6 = track_design_open(path.c_str());
         if (td6 != nullptr)
@@ -230,11 +285,52 @@ private:
             item.RideType = td6->type;
             item.ObjectEntry = std::string(td6->vehicle_object.name, 8);
             item.Flags = flags;
+            if (fileInfo != nullptr)
+            {
+                item.FileSize = fileInfo->Size;
+                item.FileLastModified = fileInfo->LastModified;
+            }
             _items.push_back(item);
             track_design_dispose(td6);
         }
     }
 
+    static std::string GetObjectEntryKey(const std::string &entry)
+    {
+        std::string key = entry;
+        for (char &ch : key)
+        {
+            ch = (char)tolower((uint8)ch);
+        }
+        return key;
+    }
+
+    const std::vector<size_t> &GetItemIndicesForObjectEntry(const std::string &entry) const
+    {
+        static const std::vector<size_t> NoItems;
+        auto kvp = _itemsByObjectEntry.find(GetObjectEntryKey(entry));
+        if (kvp != _itemsByObjectEntry.end())
+        {
+            return kvp->second;
+        }
+        return NoItems;
+    }
+
+    void UpdateLookupMaps()
+    {
+        for (auto &indices : _itemsByRideType)
+        {
+            indices.clear();
+        }
+        _itemsByObjectEntry.clear();
+        for (size_t i = 0; i < _items.size(); i++)
+        {
+            const TrackRepositoryItem &item = _items[i];
+            _itemsByRideType[item.RideType].push_back(i);
+            _itemsByObjectEntry[GetObjectEntryKey(item.ObjectEntry)].push_back(i);
+        }
+    }
+
     void SortItems()
     {
         std::sort(_items.begin(), _items.end(), [](const TrackRepositoryItem &a,
@@ -248,7 +344,11 @@ private:
             });
     }
 
-    bool Load()
+    /**
+     * Loads the index. If the index is out of date, its items are returned in outdatedItems so
+     * they can be reused by a scan.
+     */
+    bool Load(std::vector<TrackRepositoryItem> * outdatedItems)
     {
         std::string path = _env->GetFilePath(PATHID::CACHE_TRACKS);
         bool result = false;
@@ -259,13 +359,16 @@ private:
             // Read header, check if we need to re-scan
             auto header = fs.ReadValue<TrackRepositoryHeader>();
             if (header.MagicNumber == TRACK_REPOSITORY_MAGIC_NUMBER &&
-                header.Version == TRACK_REPOSITORY_VERSION &&
-                header.TotalFiles == _directoryQueryResult.TotalFiles &&
-                header.TotalFileSize == _directoryQueryResult.TotalFileSize &&
-                header.FileDateModifiedChecksum == _directoryQueryResult.FileDateModifiedChecksum &&
-                header.PathChecksum == _directoryQueryResult.PathChecksum)
+                header.Version == TRACK_REPOSITORY_VERSION)
             {
-                // Directory is the same, just read the saved items
+                bool upToDate =
+                    header.TotalFiles == _directoryQueryResult.TotalFiles &&
+                    header.TotalFileSize == _directoryQueryResult.TotalFileSize &&
+                    header.FileDateModifiedChecksum == _directoryQueryResult.FileDateModifiedChecksum &&
+                    header.PathChecksum == _directoryQueryResult.PathChecksum;
+
+                // If the directory is the same, just use the saved items
+                std::vector<TrackRepositoryItem> * items = upToDate ? &_items : outdatedItems;
                 for (uint32 i = 0; i < header.NumItems; i++)
                 {
                     TrackRepositoryItem item;
@@ -274,14 +377,18 @@ private:
                     item.RideType = fs.ReadValue<uint8>();
                     item.ObjectEntry = fs.ReadStdString();
                     item.Flags = fs.ReadValue<uint32>();
-                    _items.push_back(item);
+                    item.FileSize = fs.ReadValue<uint64>();
+                    item.FileLastModified = fs.ReadValue<uint64>();
+                    items->push_back(item);
                 }
-                result = true;
+                result = upToDate;
             }
         }
         catch (const Exception &)
         {
-            Console::Error::WriteLine("Unable to write object repository index.");
+            Console::Error::WriteLine("Unable to read track repository index.");
+            _items.clear();
+            outdatedItems->clear();
         }
         return result;
     }
@@ -312,6 +419,8 @@ private:
                 fs.WriteValue(item.RideType);
                 fs.WriteString(item.ObjectEntry);
                 fs.WriteValue(item.Flags);
+                fs.WriteValue(item.FileSize);
+                fs.WriteValue(item.FileLastModified);
             }
         }
         catch (const Exception &)
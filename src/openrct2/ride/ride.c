@@ -1933,6 +1933,65 @@ sint32 sub_6CC3FB(sint32 rideIndex)
 
 #pragma region Update functions
 
+/**
+ * The values of a ride shown in the ride list, kept so the list is only redrawn when they change.
+ */
+typedef struct ride_list_values {
+	uint8 status;
+	uint8 popularity;
+	uint8 satisfaction;
+	uint8 num_riders;
+	uint8 reliability;
+	uint8 downtime;
+	uint16 race_winner;
+	uint16 guests_favourite;
+	uint16 queue_length;
+	sint32 queue_time;
+	sint32 age;
+	uint32 lifecycle_flags;
+	uint32 total_customers;
+	uint32 customers_per_hour;
+	money32 profit;
+	money32 total_profit;
+	money32 income_per_hour;
+	money32 upkeep_cost;
+} ride_list_values;
+
+static ride_list_values _rideListValues[MAX_RIDES];
+
+/**
+ * Flags the ride list for a refresh if any of the values it shows for the given ride have changed
+ * since the last update.
+ */
+static void ride_update_list_invalidate_flags(sint32 rideIndex, rct_ride *ride)
+{
+	ride_list_values values;
+	memset(&values, 0, sizeof(values));
+	values.status = ride->status;
+	values.popularity = ride->popularity;
+	values.satisfaction = ride->satisfaction;
+	values.num_riders = ride->num_riders;
+	values.reliability = ride->reliability >> 8;
+	values.downtime = ride->downtime;
+	values.race_winner = ride->race_winner;
+	values.guests_favourite = ride->guests_favourite;
+	values.queue_length = ride_get_total_queue_length(ride);
+	values.queue_time = ride_get_max_queue_time(ride);
+	values.age = date_get_year(gDateMonthsElapsed - ride->build_date);
+	values.lifecycle_flags = ride->lifecycle_flags & (RIDE_LIFECYCLE_CRASHED | RIDE_LIFECYCLE_BROKEN_DOWN);
+	values.total_customers = ride->total_customers;
+	values.customers_per_hour = ride_customers_per_hour(ride);
+	values.profit = ride->profit;
+	values.total_profit = ride->total_profit;
+	values.income_per_hour = ride->income_per_hour;
+	values.upkeep_cost = ride->upkeep_cost;
+
+	if (memcmp(&values, &_rideListValues[rideIndex], sizeof(values)) != 0) {
+		_rideListValues[rideIndex] = values;
+		ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_LIST;
+	}
+}
+
 /**
  *
  *  rct2: 0x006ABE4C
@@ -1953,8 +2012,10 @@ void ride_update_all()
 	window_update_viewport_ride_music();
 
 	// Update rides
-	FOR_ALL_RIDES(i, ride)
+	FOR_ALL_RIDES(i, ride) {
 		ride_update(i);
+		ride_update_list_invalidate_flags(i, ride);
+	}
 
 	ride_music_update_final();
 }
@@ -2850,8 +2911,10 @@ static void ride_measurement_update(rct_ride_measurement *measurement)
 			return;
 
 		measurement->flags &= ~RIDE_MEASUREMENT_FLAG_UNLOADING;
-		if (measurement->current_station == vehicle->current_station)
+		if (measurement->current_station == vehicle->current_station) {
 			measurement->current_item = 0;
+			ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_GRAPH;
+		}
 	}
 
 	if (vehicle->status == VEHICLE_STATUS_UNLOADING_PASSENGERS) {
@@ -2896,6 +2959,7 @@ static void ride_measurement_update(rct_ride_measurement *measurement)
 
 	measurement->velocity[measurement->current_item] = velocity & 0xFF;
 	measurement->altitude[measurement->current_item] = altitude & 0xFF;
+	ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_GRAPH;
 
 	if (gScenarioTicks & 1) {
 		measurement->current_item++;
@@ -731,6 +731,7 @@ enum {
 	RIDE_INVALIDATE_RIDE_LIST        = 1 << 3,
 	RIDE_INVALIDATE_RIDE_OPERATING   = 1 << 4,
 	RIDE_INVALIDATE_RIDE_MAINTENANCE = 1 << 5,
+	RIDE_INVALIDATE_RIDE_GRAPH       = 1 << 6,
 };
 
 enum {
@@ -15,15 +15,20 @@
 #pragma endregion
 
 #include <algorithm>
+#include <cctype>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include "../core/Console.hpp"
 #include "../core/FileScanner.h"
 #include "../core/FileStream.hpp"
+#include "../core/FileWatcher.h"
 #include "../core/Math.hpp"
+#include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../core/Util.hpp"
+#include "../ParkFile.h"
 #include "../ParkImporter.h"
 #include "../PlatformEnvironment.h"
 #include "../rct12/SawyerChunkReader.h"
@@ -39,6 +44,26 @@ extern "C"
     #include "scenario.h"
 }
 
+constexpr uint16 SCENARIO_REPOSITORY_VERSION = 1;
+
+#pragma pack(push, 1)
+struct ScenarioRepositoryHeader
+{
+    uint16  Version;
+    uint16  LanguageId;
+    uint32  NumItems;
+};
+assert_struct_size(ScenarioRepositoryHeader, 8);
+#pragma pack(pop)
+
+struct ScenarioIndexItem
+{
+    scenario_index_entry    Entry;
+    uint64                  FileSize;
+};
+
+using ScenarioIndexMap = std::unordered_map<std::string, ScenarioIndexItem>;
+
 static sint32 ScenarioCategoryCompare(sint32 categoryA, sint32 categoryB)
 {
     if (categoryA == categoryB) return 0;
@@ -127,7 +152,11 @@ private:
 
     IPlatformEnvironment * _env;
     std::vector<scenario_index_entry> _scenarios;
+    std::unordered_map<std::string, size_t> _scenarioFilenameMap;
+    std::unordered_map<std::string, size_t> _scenarioPathMap;
     std::vector<scenario_highscore_entry*> _highscores;
+    std::unique_ptr<FileWatcher> _watcher;
+    sint32 _scannedLanguage = -1;
 
 public:
     ScenarioRepository(IPlatformEnvironment * env)
@@ -142,17 +171,46 @@ public:
 
     void Scan() override
     {
-        _scenarios.clear();
-
-        // Scan RCT2 directory
         std::string rct1dir = _env->GetDirectoryPath(DIRBASE::RCT1, DIRID::SCENARIO);
         std::string rct2dir = _env->GetDirectoryPath(DIRBASE::RCT2, DIRID::SCENARIO);
         std::string openrct2dir = _env->GetDirectoryPath(DIRBASE::USER, DIRID::SCENARIO);
-        Scan(rct1dir);
-        Scan(rct2dir);
-        Scan(openrct2dir);
+        bool changed = FileWatcher::HasChanged(_watcher, { rct1dir, rct2dir, openrct2dir }, gConfigGeneral.watch_directories);
+
+        // The names and details are translated, so they must be read again after a language change
+        if (changed || _scannedLanguage != gCurrentLanguage)
+        {
+            _scannedLanguage = gCurrentLanguage;
+            _scenarios.clear();
+            _scenarioFilenameMap.clear();
+            _scenarioPathMap.clear();
+
+            // Only files that are not in the index, or have changed since, need to be read
+            ScenarioIndexMap indexedItems = LoadIndex();
+            std::vector<ScenarioIndexItem> newIndexItems;
+
+            // Scan RCT2 directory
+            size_t numScanned = 0;
+            numScanned += Scan(rct1dir, indexedItems, newIndexItems);
+            numScanned += Scan(rct2dir, indexedItems, newIndexItems);
+            numScanned += Scan(openrct2dir, indexedItems, newIndexItems);
+
+            size_t numReused = newIndexItems.size() - numScanned;
+            if (numScanned > 0 || numReused != indexedItems.size())
+            {
+                SaveIndex(newIndexItems);
+            }
+        }
+        else
+        {
+            // The highscores are about to be reloaded
+            for (auto &scenario : _scenarios)
+            {
+                scenario.highscore = nullptr;
+            }
+        }
 
         Sort();
+        UpdateLookupMaps();
         LoadScores();
         LoadLegacyScores();
         AttachHighscores();
@@ -175,29 +233,25 @@ public:
 
     const scenario_index_entry * GetByFilename(const utf8 * filename) const override
     {
-        for (size_t i = 0; i < _scenarios.size(); i++)
+        // Note: this is always case insensitive search for cross platform consistency
+        auto kvp = _scenarioFilenameMap.find(GetLookupKey(filename, true));
+        if (kvp != _scenarioFilenameMap.end())
         {
-            const scenario_index_entry * scenario = &_scenarios[i];
-            const utf8 * scenarioFilename = Path::GetFileName(scenario->path);
-
-            // Note: this is always case insensitive search for cross platform consistency
-            if (String::Equals(filename, scenarioFilename, true))
-            {
-                return &_scenarios[i];
-            }
+            return &_scenarios[kvp->second];
         }
         return nullptr;
     }
 
     const scenario_index_entry * GetByPath(const utf8 * path) const override
     {
-        for (size_t i = 0; i < _scenarios.size(); i++)
+        bool ignoreCase = false;
+#ifdef __WINDOWS__
+        ignoreCase = true;
+#endif
+        auto kvp = _scenarioPathMap.find(GetLookupKey(path, ignoreCase));
+        if (kvp != _scenarioPathMap.end())
         {
-            const scenario_index_entry * scenario = &_scenarios[i];
-            if (Path::Equals(path, scenario->path))
-            {
-                return scenario;
-            }
+            return &_scenarios[kvp->second];
         }
         return nullptr;
     }
@@ -254,31 +308,82 @@ private:
         return (scenario_index_entry *)repo->GetByPath(path);
     }
 
-    void Scan(const std::string &directory)
+    static std::string GetLookupKey(const utf8 * str, bool ignoreCase)
+    {
+        std::string key = str;
+        if (ignoreCase)
+        {
+            for (char &ch : key)
+            {
+                ch = (char)tolower((uint8)ch);
+            }
+        }
+        return key;
+    }
+
+    void UpdateLookupMaps()
+    {
+        bool ignorePathCase = false;
+#ifdef __WINDOWS__
+        ignorePathCase = true;
+#endif
+        _scenarioFilenameMap.clear();
+        _scenarioPathMap.clear();
+        for (size_t i = 0; i < _scenarios.size(); i++)
+        {
+            const utf8 * path = _scenarios[i].path;
+            _scenarioFilenameMap.emplace(GetLookupKey(Path::GetFileName(path), true), i);
+            _scenarioPathMap.emplace(GetLookupKey(path, ignorePathCase), i);
+        }
+    }
+
+    /**
+     * Adds the scenarios in the given directory, reusing the entry from the index for any file
+     * with the same size and modification time. Returns the number of files that had to be read.
+     */
+    size_t Scan(const std::string &directory, const ScenarioIndexMap &indexedItems, std::vector<ScenarioIndexItem> &newIndexItems)
     {
         utf8 pattern[MAX_PATH];
         String::Set(pattern, sizeof(pattern), directory.c_str());
         Path::Append(pattern, sizeof(pattern), "*.sc4;*.sc6");
 
+        size_t numScanned = 0;
         IFileScanner * scanner = Path::ScanDirectory(pattern, true);
         while (scanner->Next())
         {
             auto path = scanner->GetPath();
             auto fileInfo = scanner->GetFileInfo();
-            AddScenario(path, fileInfo->LastModified);
+
+            ScenarioIndexItem item;
+            auto kvp = indexedItems.find(path);
+            if (kvp != indexedItems.end() &&
+                kvp->second.FileSize == fileInfo->Size &&
+                kvp->second.Entry.timestamp == fileInfo->LastModified)
+            {
+                item = kvp->second;
+            }
+            else if (GetScenarioInfo(path, fileInfo->LastModified, &item.Entry))
+            {
+                item.FileSize = fileInfo->Size;
+                numScanned++;
+            }
+            else
+            {
+                continue;
+            }
+
+            newIndexItems.push_back(item);
+            AddScenario(item.Entry);
         }
         delete scanner;
+        return numScanned;
     }
 
-    void AddScenario(const std::string &path, uint64 timestamp)
+    void AddScenario(const scenario_index_entry &entry)
     {
-        scenario_index_entry entry;
-        if (!GetScenarioInfo(path, timestamp, &entry))
-        {
-            return;
-        }
-
-        const std::string filename = Path::GetFileName(path);
+        const std::string path = entry.path;
+        const uint64 timestamp = entry.timestamp;
+        const std::string filename = Path::GetFileName(entry.path);
         scenario_index_entry * existingEntry = GetByFilename(filename.c_str());
         if (existingEntry != nullptr)
         {
@@ -300,10 +405,117 @@ private:
         }
         else
         {
+            _scenarioFilenameMap.emplace(GetLookupKey(filename.c_str(), true), _scenarios.size());
             _scenarios.push_back(entry);
         }
     }
 
+    ScenarioIndexMap LoadIndex() const
+    {
+        ScenarioIndexMap items;
+        std::string path = _env->GetFilePath(PATHID::CACHE_SCENARIOS);
+        if (!platform_file_exists(path.c_str()))
+        {
+            return items;
+        }
+
+        try
+        {
+            auto fs = FileStream(path, FILE_MODE_OPEN);
+            auto header = fs.ReadValue<ScenarioRepositoryHeader>();
+            if (header.Version != SCENARIO_REPOSITORY_VERSION ||
+                header.LanguageId != gCurrentLanguage)
+            {
+                // The names and details are translated, so the index is per language
+                return items;
+            }
+
+            // Buffer the rest of file into memory to speed up item reading
+            size_t dataSize = (size_t)(fs.GetLength() - fs.GetPosition());
+            void * data = fs.ReadArray<uint8>(dataSize);
+            auto ms = MemoryStream(data, dataSize, MEMORY_ACCESS::READ | MEMORY_ACCESS::OWNER);
+            for (uint32 i = 0; i < header.NumItems; i++)
+            {
+                ScenarioIndexItem item = ReadIndexItem(&ms);
+                items[item.Entry.path] = item;
+            }
+        }
+        catch (const Exception &)
+        {
+            Console::Error::WriteLine("Error reading scenario index, rebuilding.");
+            items.clear();
+        }
+        return items;
+    }
+
+    void SaveIndex(const std::vector<ScenarioIndexItem> &items) const
+    {
+        std::string path = _env->GetFilePath(PATHID::CACHE_SCENARIOS);
+        try
+        {
+            auto fs = FileStream(path, FILE_MODE_WRITE);
+
+            ScenarioRepositoryHeader header;
+            header.Version = SCENARIO_REPOSITORY_VERSION;
+            header.LanguageId = (uint16)gCurrentLanguage;
+            header.NumItems = (uint32)items.size();
+            fs.WriteValue(header);
+
+            for (const auto &item : items)
+            {
+                WriteIndexItem(&fs, item);
+            }
+        }
+        catch (const Exception &)
+        {
+            log_error("Unable to write scenario repository index to '%s'.", path.c_str());
+        }
+    }
+
+    static ScenarioIndexItem ReadIndexItem(IStream * stream)
+    {
+        ScenarioIndexItem item;
+        Memory::Set(&item, 0, sizeof(item));
+
+        scenario_index_entry * entry = &item.Entry;
+        std::string path = stream->ReadStdString();
+        String::Set(entry->path, sizeof(entry->path), path.c_str());
+        entry->timestamp = stream->ReadValue<uint64>();
+        item.FileSize = stream->ReadValue<uint64>();
+        entry->category = stream->ReadValue<uint8>();
+        entry->source_game = stream->ReadValue<uint8>();
+        entry->source_index = stream->ReadValue<sint16>();
+        entry->sc_id = stream->ReadValue<uint16>();
+        entry->objective_type = stream->ReadValue<uint8>();
+        entry->objective_arg_1 = stream->ReadValue<uint8>();
+        entry->objective_arg_2 = stream->ReadValue<sint32>();
+        entry->objective_arg_3 = stream->ReadValue<sint16>();
+        entry->highscore = nullptr;
+        std::string name = stream->ReadStdString();
+        std::string details = stream->ReadStdString();
+        String::Set(entry->name, sizeof(entry->name), name.c_str());
+        String::Set(entry->details, sizeof(entry->details), details.c_str());
+        return item;
+    }
+
+    static void WriteIndexItem(IStream * stream, const ScenarioIndexItem &item)
+    {
+        const scenario_index_entry * entry = &item.Entry;
+        stream->WriteString(entry->path);
+        stream->WriteValue<uint64>(entry->timestamp);
+        stream->WriteValue<uint64>(item.FileSize);
+        stream->WriteValue<uint8>(entry->category);
+        stream->WriteValue<uint8>(entry->source_game);
+        stream->WriteValue<sint16>(entry->source_index);
+        stream->WriteValue<uint16>(entry->sc_id);
+        stream->WriteValue<uint8>(entry->objective_type);
+        stream->WriteValue<uint8>(entry->objective_arg_1);
+        stream->WriteValue<sint32>(entry->objective_arg_2);
+        stream->WriteValue<sint16>(entry->objective_arg_3);
+        stream->WriteString(entry->name);
+        stream->WriteString(entry->details);
+    }
+
     /**
      * Reads basic information from a scenario file.
      */
@@ -337,6 +549,21 @@ private:
             {
                 // RCT2 scenario
                 auto fs = FileStream(path, FILE_MODE_OPEN);
+                if (ParkFile::IsParkFile(&fs))
+                {
+                    // Only the meta section needs to be decompressed
+                    rct_s6_header header;
+                    rct_s6_info info;
+                    ParkFile::ReadMeta(&fs, &header, &info);
+                    if (header.type == S6_TYPE_SCENARIO)
+                    {
+                        *entry = CreateNewScenarioEntry(path, timestamp, &info);
+                        return true;
+                    }
+                    log_verbose("%s is not a scenario", path.c_str());
+                    return false;
+                }
+
                 auto chunkReader = SawyerChunkReader(&fs);
 
                 rct_s6_header header = chunkReader.ReadChunkAs<rct_s6_header>();
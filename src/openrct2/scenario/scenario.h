@@ -397,6 +397,8 @@ uint32 scenario_rand();
 uint32 scenario_rand_max(uint32 max);
 sint32 scenario_prepare_for_save();
 sint32 scenario_save(const utf8 * path, sint32 flags);
+bool scenario_autosave(const utf8 * path, const utf8 * backupPath, const utf8 * prunePattern, size_t numberOfFilesToKeep, sint32 flags);
+void scenario_autosave_wait();
 void scenario_remove_trackless_rides(rct_s6_data *s6);
 void scenario_fix_ghosts(rct_s6_data *s6);
 void scenario_set_filename(const char *value);
@@ -23,6 +23,7 @@ static size_t decode_chunk_rle(const uint8* src_buffer, uint8* dst_buffer, size_
 static size_t decode_chunk_rle_with_size(const uint8* src_buffer, uint8* dst_buffer, size_t length, size_t dstSize);
 static size_t decode_chunk_repeat(uint8 *buffer, size_t length);
 static void decode_chunk_rotate(uint8 *buffer, size_t length);
+static bool get_rle_decoded_length(const uint8 *src_buffer, size_t length, size_t *rleLength, size_t *repeatLength);
 
 static size_t encode_chunk_rle(const uint8 *src_buffer, uint8 *dst_buffer, size_t length);
 static size_t encode_chunk_repeat(const uint8 *src_buffer, uint8 *dst_buffer, size_t length);
@@ -31,15 +32,48 @@ static void encode_chunk_rotate(uint8 *buffer, size_t length);
 bool gUseRLE = true;
 
 uint32 sawyercoding_calculate_checksum(const uint8* buffer, size_t length)
+{
+	return sawyercoding_update_checksum(0, buffer, length);
+}
+
+/**
+ * Adds the given bytes to a running checksum, allowing a file's checksum to be calculated as it is written.
+ */
+uint32 sawyercoding_update_checksum(uint32 checksum, const uint8* buffer, size_t length)
 {
 	size_t i;
-	uint32 checksum = 0;
 	for (i = 0; i < length; i++)
 		checksum += buffer[i];
 
 	return checksum;
 }
 
+/**
+ * Calculates the size of the buffer sawyercoding_read_chunk_buffer needs to decode the given chunk
+ * by walking the encoded data, without decoding it. RLE compressed chunks are decoded in place, so
+ * the buffer must fit both the intermediate RLE decoded data and the final data.
+ * @returns false if the encoded data is truncated.
+ */
+bool sawyercoding_get_decode_buffer_size(const uint8 *src_buffer, sawyercoding_chunk_header chunkHeader, size_t *bufferSize)
+{
+	size_t rleLength, repeatLength;
+	switch (chunkHeader.encoding) {
+	case CHUNK_ENCODING_RLE:
+		if (!get_rle_decoded_length(src_buffer, chunkHeader.length, &rleLength, NULL))
+			return false;
+		*bufferSize = rleLength;
+		return true;
+	case CHUNK_ENCODING_RLECOMPRESSED:
+		if (!get_rle_decoded_length(src_buffer, chunkHeader.length, &rleLength, &repeatLength))
+			return false;
+		*bufferSize = max(rleLength, repeatLength);
+		return true;
+	default:
+		*bufferSize = chunkHeader.length;
+		return true;
+	}
+}
+
 size_t sawyercoding_read_chunk_buffer(uint8 *dst_buffer, const uint8 *src_buffer, sawyercoding_chunk_header chunkHeader, size_t dst_buffer_size) {
 	switch (chunkHeader.encoding) {
 	case CHUNK_ENCODING_NONE:
@@ -263,6 +297,62 @@ static size_t decode_chunk_rle_with_size(const uint8* src_buffer, uint8* dst_buf
 	return dst - dst_buffer;
 }
 
+/**
+ * Measures the output of decode_chunk_rle and optionally of decode_chunk_repeat run on its output.
+ */
+static bool get_rle_decoded_length(const uint8 *src_buffer, size_t length, size_t *rleLength, size_t *repeatLength)
+{
+	size_t rleCount = 0;
+	size_t repeatCount = 0;
+	bool literalNext = false;
+
+	for (size_t i = 0; i < length; i++) {
+		uint8 rleCodeByte = src_buffer[i];
+		size_t count;
+		const uint8 *run;
+		size_t runStride;
+		if (rleCodeByte & 128) {
+			if (++i >= length)
+				return false;
+			count = 257 - rleCodeByte;
+			run = &src_buffer[i];
+			runStride = 0;
+		} else {
+			count = rleCodeByte + 1;
+			if (i + count >= length)
+				return false;
+			run = &src_buffer[i + 1];
+			runStride = 1;
+			i += count;
+		}
+		rleCount += count;
+
+		if (repeatLength != NULL) {
+			// Walk the RLE decoded bytes as repeat codes, a code of 0xFF is followed by a literal byte
+			for (size_t j = 0; j < count; j++) {
+				uint8 repeatCodeByte = run[j * runStride];
+				if (literalNext) {
+					repeatCount++;
+					literalNext = false;
+				} else if (repeatCodeByte == 0xFF) {
+					literalNext = true;
+				} else {
+					repeatCount += (repeatCodeByte & 7) + 1;
+				}
+			}
+		}
+	}
+
+	// A trailing 0xFF code still writes a byte
+	if (literalNext)
+		repeatCount++;
+
+	*rleLength = rleCount;
+	if (repeatLength != NULL)
+		*repeatLength = repeatCount;
+	return true;
+}
+
 /**
  *
  *  rct2: 0x006769F1
@@ -360,11 +450,33 @@ static size_t encode_chunk_rle(const uint8 *src_buffer, uint8 *dst_buffer, size_
 	return dst - dst_buffer;
 }
 
+/**
+ * Returns a mask of which of the 32 bytes before position have the given value, bit (32 - n) being
+ * set if the byte n back does, and records the value at position for the following positions.
+ * Must be called for every position in order. Each value's mask is only updated when the value
+ * occurs and is shifted along to the position being looked at when it is read.
+ */
+static uint32 encode_chunk_repeat_match_mask(uint32 *valueMasks, size_t *valueMaskPositions, uint8 value, size_t position)
+{
+	size_t age = position - valueMaskPositions[value];
+	uint32 mask = age < 32 ? valueMasks[value] >> age : 0;
+	valueMasks[value] = (mask >> 1) | 0x80000000;
+	valueMaskPositions[value] = position + 1;
+	return mask;
+}
+
 static size_t encode_chunk_repeat(const uint8 *src_buffer, uint8 *dst_buffer, size_t length)
 {
 	if (length == 0)
 		return 0;
 
+	uint32 valueMasks[256] = { 0 };
+	size_t valueMaskPositions[256] = { 0 };
+
+	// Match masks of the current position and up to 7 positions after it
+	uint32 matchMasks[8];
+	size_t numMatchMasks = 0;
+
 	size_t outLength = 0;
 
 	// Need to emit at least one byte, otherwise there is nothing to repeat
@@ -374,32 +486,24 @@ static size_t encode_chunk_repeat(const uint8 *src_buffer, uint8 *dst_buffer, si
 
 	// Iterate through remainder of the source buffer
 	for (size_t i = 1; i < length; ) {
-		size_t searchIndex = (i < 32) ? 0 : (i - 32);
-		size_t searchEnd = i - 1;
+		// Maximum repeat count is 8
+		size_t maxRepeatCount = min(8, length - i);
+		while (numMatchMasks < i + maxRepeatCount) {
+			matchMasks[numMatchMasks & 7] = encode_chunk_repeat_match_mask(valueMasks, valueMaskPositions, src_buffer[numMatchMasks], numMatchMasks);
+			numMatchMasks++;
+		}
 
-		size_t bestRepeatIndex = 0;
+		// Narrow down the earlier positions that still match one byte further each step, a repeat
+		// can not be longer than its distance back
+		uint32 repeatMask = matchMasks[i & 7];
+		uint32 bestRepeatMask = 0;
 		size_t bestRepeatCount = 0;
-		for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++) {
-			size_t repeatCount = 0;
-			size_t maxRepeatCount = min(min(7, searchEnd - repeatIndex), length - i - 1);
-			// maxRepeatCount should not exceed length
-			assert(repeatIndex + maxRepeatCount < length);
-			assert(i + maxRepeatCount < length);
-			for (size_t j = 0; j <= maxRepeatCount; j++) {
-				if (src_buffer[repeatIndex + j] == src_buffer[i + j]) {
-					repeatCount++;
-				} else {
-					break;
-				}
-			}
-			if (repeatCount > bestRepeatCount) {
-				bestRepeatIndex = repeatIndex;
-				bestRepeatCount = repeatCount;
-
-				// Maximum repeat count is 8
-				if (repeatCount == 8)
-					break;
-			}
+		while (repeatMask != 0) {
+			bestRepeatMask = repeatMask;
+			bestRepeatCount++;
+			if (bestRepeatCount == maxRepeatCount)
+				break;
+			repeatMask &= matchMasks[(i + bestRepeatCount) & 7] & (0xFFFFFFFF >> bestRepeatCount);
 		}
 
 		if (bestRepeatCount == 0) {
@@ -408,7 +512,9 @@ static size_t encode_chunk_repeat(const uint8 *src_buffer, uint8 *dst_buffer, si
 			outLength += 2;
 			i++;
 		} else {
-			*dst_buffer++ = (uint8)((bestRepeatCount - 1) | ((32 - (i - bestRepeatIndex)) << 3));
+			// Use the furthest back of the longest repeats, its bit is the offset to encode
+			sint32 repeatOffset = bitscanforward((sint32)bestRepeatMask);
+			*dst_buffer++ = (uint8)((bestRepeatCount - 1) | (repeatOffset << 3));
 			outLength++;
 			i += bestRepeatCount;
 		}
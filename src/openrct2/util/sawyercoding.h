@@ -50,6 +50,8 @@ enum {
 };
 
 uint32 sawyercoding_calculate_checksum(const uint8* buffer, size_t length);
+uint32 sawyercoding_update_checksum(uint32 checksum, const uint8* buffer, size_t length);
+bool sawyercoding_get_decode_buffer_size(const uint8 *src_buffer, sawyercoding_chunk_header chunkHeader, size_t *bufferSize);
 size_t sawyercoding_read_chunk_buffer(uint8 *dst_buffer, const uint8 *src_buffer, sawyercoding_chunk_header chunkHeader, size_t dst_buffer_size);
 size_t sawyercoding_write_chunk_buffer(uint8 *dst_file, const uint8 *src_buffer, sawyercoding_chunk_header chunkHeader);
 size_t sawyercoding_decode_sv4(const uint8 *src, uint8 *dst, size_t length, size_t bufferLength);
@@ -175,6 +175,7 @@ sint32 bitscanforward(sint32 source)
 	#define OpenRCT2_POPCNT_GNUC
 #elif defined(_MSC_VER) && (_MSC_VER >= 1500) && (defined(_M_X64) || defined(_M_IX86)) // VS2008
 	#include <nmmintrin.h>
+	#include <immintrin.h>
 	#define OpenRCT2_POPCNT_MSVC
 #endif
 
@@ -240,6 +241,44 @@ sint32 bitcount(uint32 source)
 	return bitcount_fn(source);
 }
 
+bool avx2_available()
+{
+	// AVX2 support is declared as the 5th bit of EBX with CPUID(EAX = 7, ECX = 0).
+	// The OS must also have enabled saving of the YMM registers (OSXSAVE + XCR0).
+	#if defined(OpenRCT2_POPCNT_GNUC)
+		uint32 eax, ebx, ecx = 0, edx;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+			return false;
+		}
+		if (!(ecx & (1 << 27)) || !(ecx & (1 << 28))) {
+			return false;
+		}
+		uint32 xcr0, xcr0High;
+		asm volatile ("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+		if ((xcr0 & 6) != 6) {
+			return false;
+		}
+		ebx = 0;
+		if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+			return false;
+		}
+		return (ebx & (1 << 5));
+	#elif defined(OpenRCT2_POPCNT_MSVC)
+		sint32 regs[4];
+		__cpuid(regs, 1);
+		if (!(regs[2] & (1 << 27)) || !(regs[2] & (1 << 28))) {
+			return false;
+		}
+		if ((_xgetbv(0) & 6) != 6) {
+			return false;
+		}
+		__cpuidex(regs, 7, 0);
+		return (regs[1] & (1 << 5));
+	#else
+		return false;
+	#endif
+}
+
 bool strequals(const char *a, const char *b, sint32 length, bool caseInsensitive)
 {
 	return caseInsensitive ?
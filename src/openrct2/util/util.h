@@ -39,6 +39,7 @@ bool writeentirefile(const utf8 * path, const void * buffer, size_t length);
 sint32 bitscanforward(sint32 source);
 void bitcount_init();
 sint32 bitcount(uint32 source);
+bool avx2_available();
 bool strequals(const char *a, const char *b, sint32 length, bool caseInsensitive);
 sint32 strcicmp(char const *a, char const *b);
 sint32 strlogicalcmp(char const *a, char const *b);
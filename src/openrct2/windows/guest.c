@@ -1282,6 +1282,97 @@ void window_guest_unknown_05(rct_window *w)
 	widget_invalidate(w, WIDX_TAB_1);
 }
 
+/**
+ * Gets the lengths and colours of the happiness, energy, hunger, thirst, nausea and bathroom bars.
+ * Colours contain flag 0x80000000 for bars that blink.
+ */
+static void window_guest_stats_get_bars(rct_peep *peep, sint32 *values, sint32 *colours)
+{
+	//Happiness
+	sint32 happiness = peep->happiness;
+	if (happiness < 10)happiness = 10;
+	sint32 ebp = COLOUR_BRIGHT_GREEN;
+	if (happiness < 50){
+		ebp |= 0x80000000;
+	}
+	values[0] = happiness;
+	colours[0] = ebp;
+
+	//Energy
+	sint32 energy = ((peep->energy - 32) * 85) / 32;
+	ebp = COLOUR_BRIGHT_GREEN;
+	if (energy < 50){
+		ebp |= 0x80000000;
+	}
+	if (energy < 10)energy = 10;
+	values[1] = energy;
+	colours[1] = ebp;
+
+	//Hunger
+	sint32 hunger = peep->hunger;
+	if (hunger > 190) hunger = 190;
+
+	hunger -= 32;
+	if (hunger < 0) hunger = 0;
+	hunger *= 51;
+	hunger /= 32;
+	hunger = 0xFF & ~hunger;
+
+	ebp = COLOUR_BRIGHT_RED;
+	if (hunger > 170){
+		ebp |= 0x80000000;
+	}
+	values[2] = hunger;
+	colours[2] = ebp;
+
+	//Thirst
+	sint32 thirst = peep->thirst;
+	if (thirst > 190) thirst = 190;
+
+	thirst -= 32;
+	if (thirst < 0) thirst = 0;
+	thirst *= 51;
+	thirst /= 32;
+	thirst = 0xFF & ~thirst;
+
+	ebp = COLOUR_BRIGHT_RED;
+	if (thirst > 170){
+		ebp |= 0x80000000;
+	}
+	values[3] = thirst;
+	colours[3] = ebp;
+
+	//Nausea
+	sint32 nausea = peep->nausea - 32;
+
+	if (nausea  < 0) nausea = 0;
+	nausea *= 36;
+	nausea /= 32;
+
+	ebp = COLOUR_BRIGHT_RED;
+	if (nausea > 120){
+		ebp |= 0x80000000;
+	}
+	values[4] = nausea;
+	colours[4] = ebp;
+
+	//Bathroom
+	sint32 bathroom = peep->bathroom - 32;
+	if (bathroom > 210) bathroom = 210;
+
+	bathroom -= 32;
+	if (bathroom < 0) bathroom = 0;
+	bathroom *= 45;
+	bathroom /= 32;
+
+	ebp = COLOUR_BRIGHT_RED;
+	if (bathroom > 160){
+		ebp |= 0x80000000;
+	}
+	values[5] = bathroom;
+	colours[5] = ebp;
+}
+
 /**
  *
  *  rct2: 0x69746A
@@ -1289,10 +1380,30 @@ void window_guest_unknown_05(rct_window *w)
 void window_guest_stats_update(rct_window *w)
 {
 	w->frame_no++;
+
+	widget_invalidate(w, WIDX_TAB_2);
+
 	rct_peep* peep = GET_PEEP(w->number);
-	peep->window_invalidate_flags &= ~PEEP_INVALIDATE_PEEP_STATS;
+	if (peep->window_invalidate_flags & (PEEP_INVALIDATE_PEEP_STATS | PEEP_INVALIDATE_PEEP_2)) {
+		peep->window_invalidate_flags &= ~(PEEP_INVALIDATE_PEEP_STATS | PEEP_INVALIDATE_PEEP_2);
+		widget_invalidate(w, WIDX_PAGE_BACKGROUND);
+		return;
+	}
 
-	window_invalidate(w);
+	// Bars of stats that need attention blink while the game is running. Several ticks pass per
+	// update at higher game speeds, so compare the blink phase with the one last drawn.
+	sint16 blinkPhase = gCurrentTicks & 8;
+	if (!game_is_paused() && w->var_4AE != blinkPhase) {
+		w->var_4AE = blinkPhase;
+		sint32 values[6], colours[6];
+		window_guest_stats_get_bars(peep, values, colours);
+		for (sint32 i = 0; i < 6; i++) {
+			if (colours[i] & 0x80000000) {
+				widget_invalidate(w, WIDX_PAGE_BACKGROUND);
+				break;
+			}
+		}
+	}
 }
 
 /**
@@ -1376,100 +1487,24 @@ void window_guest_stats_paint(rct_window *w, rct_drawpixelinfo *dpi)
 	//dx
 	sint32 y = w->y + window_guest_rides_widgets[WIDX_PAGE_BACKGROUND].top + 4;
 
-	//Happiness
-	gfx_draw_string_left(dpi, STR_GUEST_STAT_HAPPINESS_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
-
-	sint32 happiness = peep->happiness;
-	if (happiness < 10)happiness = 10;
-	sint32 ebp = COLOUR_BRIGHT_GREEN;
-	if (happiness < 50){
-		ebp |= 0x80000000;
-	}
-	window_guest_stats_bars_paint(happiness, x, y, w, dpi, ebp);
-
-	//Energy
-	y += 10;
-	gfx_draw_string_left(dpi, STR_GUEST_STAT_ENERGY_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
-
-	sint32 energy = ((peep->energy - 32) * 85) / 32;
-	ebp = COLOUR_BRIGHT_GREEN;
-	if (energy < 50){
-		ebp |= 0x80000000;
-	}
-	if (energy < 10)energy = 10;
-	window_guest_stats_bars_paint(energy, x, y, w, dpi, ebp);
-
-	//Hunger
-	y += 10;
-	gfx_draw_string_left(dpi, STR_GUEST_STAT_HUNGER_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
-
-	sint32 hunger = peep->hunger;
-	if (hunger > 190) hunger = 190;
-
-	hunger -= 32;
-	if (hunger < 0) hunger = 0;
-	hunger *= 51;
-	hunger /= 32;
-	hunger = 0xFF & ~hunger;
-
-	ebp = COLOUR_BRIGHT_RED;
-	if (hunger > 170){
-		ebp |= 0x80000000;
-	}
-	window_guest_stats_bars_paint(hunger, x, y, w, dpi, ebp);
-
-	//Thirst
-	y += 10;
-	gfx_draw_string_left(dpi, STR_GUEST_STAT_THIRST_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
-
-	sint32 thirst = peep->thirst;
-	if (thirst > 190) thirst = 190;
-
-	thirst -= 32;
-	if (thirst < 0) thirst = 0;
-	thirst *= 51;
-	thirst /= 32;
-	thirst = 0xFF & ~thirst;
-
-	ebp = COLOUR_BRIGHT_RED;
-	if (thirst > 170){
-		ebp |= 0x80000000;
-	}
-	window_guest_stats_bars_paint(thirst, x, y, w, dpi, ebp);
-
-	//Nausea
-	y += 10;
-	gfx_draw_string_left(dpi, STR_GUEST_STAT_NAUSEA_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
-
-	sint32 nausea = peep->nausea - 32;
-
-	if (nausea  < 0) nausea = 0;
-	nausea *= 36;
-	nausea /= 32;
-
-	ebp = COLOUR_BRIGHT_RED;
-	if (nausea > 120){
-		ebp |= 0x80000000;
-	}
-	window_guest_stats_bars_paint(nausea, x, y, w, dpi, ebp);
-
-	//Bathroom
-	y += 10;
-	gfx_draw_string_left(dpi, STR_GUEST_STAT_TOILET_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y);
-
-	sint32 bathroom = peep->bathroom - 32;
-	if (bathroom > 210) bathroom = 210;
-
-	bathroom -= 32;
-	if (bathroom < 0) bathroom = 0;
-	bathroom *= 45;
-	bathroom /= 32;
+	static const rct_string_id barLabels[] = {
+		STR_GUEST_STAT_HAPPINESS_LABEL,
+		STR_GUEST_STAT_ENERGY_LABEL,
+		STR_GUEST_STAT_HUNGER_LABEL,
+		STR_GUEST_STAT_THIRST_LABEL,
+		STR_GUEST_STAT_NAUSEA_LABEL,
+		STR_GUEST_STAT_TOILET_LABEL,
+	};
 
-	ebp = COLOUR_BRIGHT_RED;
-	if (bathroom > 160){
-		ebp |= 0x80000000;
+	sint32 values[6], colours[6];
+	window_guest_stats_get_bars(peep, values, colours);
+	for (sint32 i = 0; i < 6; i++) {
+		if (i != 0) {
+			y += 10;
+		}
+		gfx_draw_string_left(dpi, barLabels[i], gCommonFormatArgs, COLOUR_BLACK, x, y);
+		window_guest_stats_bars_paint(values[i], x, y, w, dpi, colours[i]);
 	}
-	window_guest_stats_bars_paint(bathroom, x, y, w, dpi, ebp);
 
 	// Time in park
 	y += 11;
@@ -1750,6 +1785,12 @@ void window_guest_finance_update(rct_window *w)
 
 	widget_invalidate(w, WIDX_TAB_2);
 	widget_invalidate(w, WIDX_TAB_4);
+
+	rct_peep* peep = GET_PEEP(w->number);
+	if (peep->window_invalidate_flags & PEEP_INVALIDATE_PEEP_FINANCE) {
+		peep->window_invalidate_flags &= ~PEEP_INVALIDATE_PEEP_FINANCE;
+		widget_invalidate(w, WIDX_PAGE_BACKGROUND);
+	}
 }
 
 /**
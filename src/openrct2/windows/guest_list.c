@@ -147,14 +147,28 @@ static sint32 _window_guest_list_num_groups;        // 0x00F1AF22
 static bool _window_guest_list_tracking_only;
 static uint16 _window_guest_list_filter_arguments[4];
 
-static uint16 _window_guest_list_groups_num_guests[240];
-static uint32 _window_guest_list_groups_argument_1[240];
-static uint32 _window_guest_list_groups_argument_2[240];
-static uint8 _window_guest_list_groups_guest_faces[240 * 58];
-static uint8 _window_guest_list_group_index[240];
+#define GUEST_GROUP_MAX_FACES 56
+
+typedef struct guest_group {
+	uint32 argument_1;
+	uint32 argument_2;
+	sint32 order;
+	uint16 num_guests;
+	uint8 faces[GUEST_GROUP_MAX_FACES];
+} guest_group;
+
+static guest_group *_window_guest_list_groups;
+static sint32 _window_guest_list_groups_capacity;
+
+// Open addressed table of indices into _window_guest_list_groups keyed by the group arguments, -1 for an empty slot
+static sint32 *_window_guest_list_group_table;
+static uint32 _window_guest_list_group_table_mask;
 
 static sint32 window_guest_list_is_peep_in_filter(rct_peep* peep);
 static void window_guest_list_find_groups();
+static bool window_guest_list_reserve_groups(sint32 numGroups);
+static uint32 window_guest_list_hash_group(uint32 argument1, uint32 argument2);
+static sint32 window_guest_list_group_compare(const void *a, const void *b);
 
 static void get_arguments_from_peep(rct_peep *peep, uint32 *argument_1, uint32* argument_2);
 
@@ -553,8 +567,8 @@ static void window_guest_list_scrollmousedown(rct_window *w, sint32 scrollIndex,
 	case PAGE_SUMMARISED:
 		i = y / 21;
 		if (i < _window_guest_list_num_groups) {
-			memcpy(_window_guest_list_filter_arguments + 0, &_window_guest_list_groups_argument_1[i], 4);
-			memcpy(_window_guest_list_filter_arguments + 2, &_window_guest_list_groups_argument_2[i], 4);
+			memcpy(_window_guest_list_filter_arguments + 0, &_window_guest_list_groups[i].argument_1, 4);
+			memcpy(_window_guest_list_filter_arguments + 2, &_window_guest_list_groups[i].argument_2, 4);
 			_window_guest_list_selected_filter = _window_guest_list_selected_view;
 			_window_guest_list_selected_tab = PAGE_INDIVIDUAL;
 			window_guest_list_widgets[WIDX_TRACKING].type = WWT_FLATBTN;
@@ -799,13 +813,14 @@ static void window_guest_list_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi,
 				}
 
 				// Draw guest faces
-				numGuests = _window_guest_list_groups_num_guests[i];
-				for (j = 0; j < 56 && j < numGuests; j++)
-					gfx_draw_sprite(dpi, _window_guest_list_groups_guest_faces[i * 56 + j] + SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY, j * 8, y + 9, 0);
+				const guest_group *group = &_window_guest_list_groups[i];
+				numGuests = group->num_guests;
+				for (j = 0; j < GUEST_GROUP_MAX_FACES && j < numGuests; j++)
+					gfx_draw_sprite(dpi, group->faces[j] + SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY, j * 8, y + 9, 0);
 
 				// Draw action
-				set_format_arg(0, uint32, _window_guest_list_groups_argument_1[i]);
-				set_format_arg(4, uint32, _window_guest_list_groups_argument_2[i]);
+				set_format_arg(0, uint32, group->argument_1);
+				set_format_arg(4, uint32, group->argument_2);
 				set_format_arg(10, uint32, numGuests);
 				gfx_draw_string_left_clipped(dpi, format, gCommonFormatArgs, COLOUR_BLACK, 0, y - 1, 414);
 
@@ -883,13 +898,16 @@ static void get_arguments_from_peep(rct_peep *peep, uint32 *argument_1, uint32*
 }
 
 /**
- *
+ * Rebuilds the groups from scratch in a single pass over the guests, at most once every 256 ticks
+ * while the view is unchanged. The groups are not kept up to date incrementally as that would need
+ * every change to a guest's thoughts, actions or state to notify the window.
  *  rct2: 0x0069B5AE
  */
 static void window_guest_list_find_groups()
 {
-	sint32 spriteIndex, spriteIndex2, groupIndex, faceIndex;
-	rct_peep *peep, *peep2;
+	sint32 spriteIndex, groupIndex;
+	uint32 slot;
+	rct_peep *peep;
 
 	uint32 tick256 = floor2(gScenarioTicks, 256);
 	if (_window_guest_list_selected_view == _window_guest_list_last_find_groups_selected_view) {
@@ -905,98 +923,112 @@ static void window_guest_list_find_groups()
 	_window_guest_list_last_find_groups_wait = 320;
 	_window_guest_list_num_groups = 0;
 
-	// Set all guests to unassigned
-	FOR_ALL_GUESTS(spriteIndex, peep)
-		if (peep->outside_of_park == 0)
-			peep->flags |= SPRITE_FLAGS_PEEP_VISIBLE;
+	if (!window_guest_list_reserve_groups(0))
+		return;
 
-	// For each guest / group
+	memset(_window_guest_list_group_table, 0xFF, (_window_guest_list_group_table_mask + 1) * sizeof(sint32));
+
+	// Add each guest to the group with the same arguments, creating it if this is the first such guest
 	FOR_ALL_GUESTS(spriteIndex, peep) {
-		if (peep->outside_of_park != 0 || !(peep->flags & SPRITE_FLAGS_PEEP_VISIBLE))
+		if (peep->outside_of_park != 0)
 			continue;
 
-		// New group, cap at 240 though
-		groupIndex = _window_guest_list_num_groups;
-		if (groupIndex >= 240)
-			break;
-
-		_window_guest_list_num_groups++;
-		_window_guest_list_groups_num_guests[groupIndex] = 1;
-		peep->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-		get_arguments_from_peep( peep, &_window_guest_list_groups_argument_1[groupIndex], &_window_guest_list_groups_argument_2[groupIndex]);
-		memcpy(_window_guest_list_filter_arguments + 0, &_window_guest_list_groups_argument_1[groupIndex], 4);
-		memcpy(_window_guest_list_filter_arguments + 2, &_window_guest_list_groups_argument_2[groupIndex], 4);
-
-		_window_guest_list_group_index[groupIndex] = groupIndex;
-		faceIndex = groupIndex * 56;
-		_window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
-
-		// Find more peeps that belong to same group
-		FOR_ALL_GUESTS(spriteIndex2, peep2) {
-			if (peep2->outside_of_park != 0 || !(peep2->flags & SPRITE_FLAGS_PEEP_VISIBLE))
-				continue;
-
-			uint32 argument1, argument2;
-			// Get and check if in same group
-			get_arguments_from_peep(peep2, &argument1, &argument2);
-			if (argument1 != _window_guest_list_groups_argument_1[groupIndex] || argument2 != _window_guest_list_groups_argument_2[groupIndex] )
-				continue;
-
-			// Assign guest
-			_window_guest_list_groups_num_guests[groupIndex]++;
-			peep2->flags &= ~(SPRITE_FLAGS_PEEP_VISIBLE);
-
-			// Add face sprite, cap at 56 though
-			if (_window_guest_list_groups_num_guests[groupIndex] >= 56)
-				continue;
-			_window_guest_list_groups_guest_faces[faceIndex++] = get_peep_face_sprite_small(peep2) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
-		}
-
-		if (_window_guest_list_filter_arguments[0] == 0) {
-			_window_guest_list_num_groups--;
+		uint32 argument1, argument2;
+		get_arguments_from_peep(peep, &argument1, &argument2);
+		if ((argument1 & 0xFFFF) == 0)
 			continue;
+
+		// Grow before looking up so the slot found stays valid for a new group
+		if (_window_guest_list_num_groups == _window_guest_list_groups_capacity &&
+			!window_guest_list_reserve_groups(_window_guest_list_num_groups + 1)
+		) {
+			break;
 		}
 
-		sint32 curr_num_guests = _window_guest_list_groups_num_guests[groupIndex];
-		sint32 swap_position = 0;
-		//This section places the groups in size order.
+		guest_group *group;
+		slot = window_guest_list_hash_group(argument1, argument2) & _window_guest_list_group_table_mask;
 		while (1) {
-			if (swap_position >= groupIndex)
-				goto nextPeep;
-			if (curr_num_guests > _window_guest_list_groups_num_guests[swap_position])
+			groupIndex = _window_guest_list_group_table[slot];
+			if (groupIndex == -1) {
+				groupIndex = _window_guest_list_num_groups++;
+				_window_guest_list_group_table[slot] = groupIndex;
+
+				group = &_window_guest_list_groups[groupIndex];
+				group->argument_1 = argument1;
+				group->argument_2 = argument2;
+				group->order = groupIndex;
+				group->num_guests = 0;
+				break;
+			}
+
+			group = &_window_guest_list_groups[groupIndex];
+			if (group->argument_1 == argument1 && group->argument_2 == argument2)
 				break;
-			swap_position++;
-		}
 
-		sint32 argument_1 = _window_guest_list_groups_argument_1[groupIndex];
-		sint32 argument_2 = _window_guest_list_groups_argument_2[groupIndex];
-		sint32 bl = _window_guest_list_group_index[groupIndex];
+			slot = (slot + 1) & _window_guest_list_group_table_mask;
+		}
 
-		do {
-			sint32 temp = curr_num_guests;
-			curr_num_guests = _window_guest_list_groups_num_guests[swap_position];
-			_window_guest_list_groups_num_guests[swap_position] = temp;
+		// Add face sprite, cap at 56 though
+		if (group->num_guests < GUEST_GROUP_MAX_FACES)
+			group->faces[group->num_guests] = get_peep_face_sprite_small(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
+		group->num_guests++;
+	}
 
-			temp = argument_1;
-			argument_1 = _window_guest_list_groups_argument_1[swap_position];
-			_window_guest_list_groups_argument_1[swap_position] = temp;
+	// Place the groups in size order, groups of the same size stay in the order they were found
+	qsort(_window_guest_list_groups, _window_guest_list_num_groups, sizeof(guest_group), window_guest_list_group_compare);
+}
 
-			temp = argument_2;
-			argument_2 = _window_guest_list_groups_argument_2[swap_position];
-			_window_guest_list_groups_argument_2[swap_position] = temp;
+/**
+ * Makes sure there is room for the given number of groups, keeping the hash table at most half full.
+ * The groups found so far are rehashed if the table has to grow.
+ */
+static bool window_guest_list_reserve_groups(sint32 numGroups)
+{
+	if (numGroups <= _window_guest_list_groups_capacity && _window_guest_list_groups != NULL)
+		return true;
 
-			uint8 temp_faces[56];
-			memcpy(temp_faces, &(_window_guest_list_groups_guest_faces[groupIndex*56]), 56);
-			memcpy(&(_window_guest_list_groups_guest_faces[groupIndex * 56]), &(_window_guest_list_groups_guest_faces[swap_position * 56]), 56);
-			memcpy(&(_window_guest_list_groups_guest_faces[swap_position * 56]), temp_faces, 56);
+	sint32 capacity = max(64, _window_guest_list_groups_capacity);
+	while (capacity < numGroups)
+		capacity *= 2;
 
-			temp = _window_guest_list_group_index[swap_position];
-			_window_guest_list_group_index[swap_position] = bl;
-			bl = temp;
-		} while (++swap_position <= groupIndex);
+	guest_group *groups = realloc(_window_guest_list_groups, capacity * sizeof(guest_group));
+	if (groups == NULL) {
+		log_error("Unable to allocate guest groups");
+		return false;
+	}
+	_window_guest_list_groups = groups;
 
-	nextPeep:
-		;
+	sint32 *table = realloc(_window_guest_list_group_table, capacity * 2 * sizeof(sint32));
+	if (table == NULL) {
+		log_error("Unable to allocate guest group table");
+		return false;
 	}
+	_window_guest_list_group_table = table;
+	_window_guest_list_group_table_mask = (capacity * 2) - 1;
+	_window_guest_list_groups_capacity = capacity;
+
+	memset(_window_guest_list_group_table, 0xFF, (_window_guest_list_group_table_mask + 1) * sizeof(sint32));
+	for (sint32 i = 0; i < _window_guest_list_num_groups; i++) {
+		const guest_group *group = &_window_guest_list_groups[i];
+		uint32 slot = window_guest_list_hash_group(group->argument_1, group->argument_2) & _window_guest_list_group_table_mask;
+		while (_window_guest_list_group_table[slot] != -1)
+			slot = (slot + 1) & _window_guest_list_group_table_mask;
+		_window_guest_list_group_table[slot] = i;
+	}
+	return true;
+}
+
+static uint32 window_guest_list_hash_group(uint32 argument1, uint32 argument2)
+{
+	uint32 hash = (argument1 * 0x9E3779B1) ^ (argument2 * 0x85EBCA77);
+	return hash ^ (hash >> 15);
+}
+
+static sint32 window_guest_list_group_compare(const void *a, const void *b)
+{
+	const guest_group *groupA = (const guest_group*)a;
+	const guest_group *groupB = (const guest_group*)b;
+	if (groupA->num_guests != groupB->num_guests)
+		return groupB->num_guests - groupA->num_guests;
+	return groupA->order - groupB->order;
 }
@@ -172,6 +172,18 @@ static uint32 _currentLine;
 /** rct2: 0x00F1AD68 */
 static uint8 (*_mapImageData)[512][512];
 
+// Tiles that have changed since they were last drawn to the map image, one bit per tile
+static uint32 _mapDirtyTiles[256][256 / 32];
+static bool _mapDirtyRows[256];
+static bool _mapHasDirtyTiles;
+
+static bool _mapSpritesMoved;
+static uint16 _mapLastFlashingFlags;
+static sint16 _mapLastViewX;
+static sint16 _mapLastViewY;
+static sint16 _mapLastViewWidth;
+static sint16 _mapLastViewHeight;
+
 static sint32 _nextPeepSpawnIndex = 0;
 
 static void window_map_init_map();
@@ -193,6 +205,8 @@ static void window_map_set_peep_spawn_tool_down(sint32 x, sint32 y);
 static void map_window_increase_map_size();
 static void map_window_decrease_map_size();
 static void map_window_set_pixels(rct_window *w);
+static bool map_window_update_dirty_tiles(rct_window *w);
+static bool map_window_main_view_changed();
 
 static void map_window_screen_to_map(sint32 screenX, sint32 screenY, sint32 *mapX, sint32 *mapY);
 
@@ -209,6 +223,7 @@ void window_map_open()
 	if (w != NULL) {
 		w->selected_tab = 0;
 		w->list_information_type = 0;
+		_currentLine = 0;
 		return;
 	}
 
@@ -269,6 +284,37 @@ void window_map_reset()
 	window_map_center_on_view_point();
 }
 
+/**
+ * Marks the tile at the given map coordinates for redrawing on the minimap the next time the map
+ * window updates.
+ */
+void window_map_invalidate_tile(sint32 x, sint32 y)
+{
+	if (_mapImageData == NULL)
+		return;
+
+	x >>= 5;
+	y >>= 5;
+	if (x < 0 || y < 0 || x >= 256 || y >= 256)
+		return;
+
+	_mapDirtyTiles[y][x >> 5] |= 1u << (x & 31);
+	_mapDirtyRows[y] = true;
+	_mapHasDirtyTiles = true;
+}
+
+/**
+ * Notifies the minimap that a peep or vehicle has moved onto a different tile so the sprite
+ * overlay needs to be repainted.
+ */
+void window_map_invalidate_sprites()
+{
+	if (_mapImageData == NULL)
+		return;
+
+	_mapSpritesMoved = true;
+}
+
 /**
 *
 *  rct2: 0x0068D0F1
@@ -276,6 +322,7 @@ void window_map_reset()
 static void window_map_close(rct_window *w)
 {
 	free(_mapImageData);
+	_mapImageData = NULL;
 	if ((input_test_flag(INPUT_FLAG_TOOL_ACTIVE)) &&
 		gCurrentToolWidget.window_classification == w->classification &&
 		gCurrentToolWidget.window_number == w->number) {
@@ -388,6 +435,10 @@ static void window_map_mouseup(rct_window *w, sint32 widgetIndex)
 
  			w->selected_tab = widgetIndex;
  			w->list_information_type = 0;
+
+			// Every tile is coloured differently on the new tab
+			_currentLine = 0;
+			window_invalidate(w);
  		}
  	}
  }
@@ -433,10 +484,29 @@ static void window_map_update(rct_window *w)
 		window_map_center_on_view_point();
 	}
 
-	for (sint32 i = 0; i < 16; i++)
-		map_window_set_pixels(w);
+	// Only sweep the whole map after it has been reset, from then on only changed tiles are redrawn
+	bool redraw = false;
+	if (_currentLine < 256) {
+		for (sint32 i = 0; i < 16 && _currentLine < 256; i++)
+			map_window_set_pixels(w);
+		redraw = true;
+	}
+	if (map_window_update_dirty_tiles(w))
+		redraw = true;
+
+	if (_mapSpritesMoved) {
+		_mapSpritesMoved = false;
+		redraw = true;
+	}
+	if (gWindowMapFlashingFlags != _mapLastFlashingFlags) {
+		_mapLastFlashingFlags = gWindowMapFlashingFlags;
+		redraw = true;
+	}
+	if (map_window_main_view_changed())
+		redraw = true;
 
-	window_invalidate(w);
+	if (redraw)
+		widget_invalidate(w, WIDX_MAP);
 
 	// Update tab animations
 	w->list_information_type++;
@@ -452,6 +522,7 @@ static void window_map_update(rct_window *w)
 		}
 		break;
 	}
+	widget_invalidate(w, WIDX_PEOPLE_TAB + w->selected_tab);
 }
 
 /**
@@ -909,6 +980,9 @@ static void window_map_scrollpaint(rct_window *w, rct_drawpixelinfo *dpi, sint32
 static void window_map_init_map()
 {
 	memset(_mapImageData, 0x0A, sizeof(*_mapImageData));
+	memset(_mapDirtyTiles, 0, sizeof(_mapDirtyTiles));
+	memset(_mapDirtyRows, 0, sizeof(_mapDirtyRows));
+	_mapHasDirtyTiles = false;
 	_currentLine = 0;
 }
 
@@ -1645,15 +1719,44 @@ static uint16 map_window_get_pixel_colour_ride(sint32 x, sint32 y)
 	return colour & 0xFFFF;
 }
 
-static void map_window_set_pixels(rct_window *w)
+/**
+ * Returns the pixel of the map image for tile i of the given line, lines run diagonally across
+ * the image.
+ */
+static uint8 *map_window_get_pixel_destination(sint32 line, sint32 i)
+{
+	sint32 pos = (line * 511) + 255;
+	rct_xy16 destinationPosition = {.y = pos / 512, .x = pos % 512};
+	return &(*_mapImageData)[destinationPosition.y + i][destinationPosition.x + i];
+}
+
+static void map_window_set_pixel(rct_window *w, sint32 x, sint32 y, uint8 *destination)
 {
 	uint16 colour = 0;
-	uint8 *destination;
+
+	if (
+		x > 0 &&
+		y > 0 &&
+		x < gMapSizeUnits &&
+		y < gMapSizeUnits
+	) {
+		switch (w->selected_tab) {
+		case PAGE_PEEPS:
+			colour = map_window_get_pixel_colour_peep(x, y);
+			break;
+		case PAGE_RIDES:
+			colour = map_window_get_pixel_colour_ride(x, y);
+			break;
+		}
+		destination[0] = HIBYTE(colour);
+		destination[1] = LOBYTE(colour);
+	}
+}
+
+static void map_window_set_pixels(rct_window *w)
+{
 	sint32 x = 0, y = 0, dx = 0, dy = 0;
 
-	sint32 pos = (_currentLine * 511) + 255;
-	rct_xy16 destinationPosition = {.y = pos/512, .x = pos % 512};
-	destination = &(*_mapImageData)[destinationPosition.y][destinationPosition.x];
 	switch (get_current_rotation()) {
 	case 0:
 		x = _currentLine * 32;
@@ -1682,33 +1785,92 @@ static void map_window_set_pixels(rct_window *w)
 	}
 
 	for (sint32 i = 0; i < 256; i++) {
-		if (
-			x > 0 &&
-			y > 0 &&
-			x < gMapSizeUnits &&
-			y < gMapSizeUnits
-		) {
-			switch (w->selected_tab) {
-			case PAGE_PEEPS:
-				colour = map_window_get_pixel_colour_peep(x, y);
-				break;
-			case PAGE_RIDES:
-				colour = map_window_get_pixel_colour_ride(x, y);
-				break;
-			}
-			destination[0] = HIBYTE(colour);
-			destination[1] = LOBYTE(colour);
-		}
+		map_window_set_pixel(w, x, y, map_window_get_pixel_destination(_currentLine, i));
 		x += dx;
 		y += dy;
-
-		destinationPosition.x++;
-		destinationPosition.y++;
-		destination = &(*_mapImageData)[destinationPosition.y][destinationPosition.x];
 	}
 	_currentLine++;
-	if (_currentLine >= 256)
-		_currentLine = 0;
+}
+
+/**
+ * Redraws a single tile, the inverse of the line / tile mapping in map_window_set_pixels.
+ */
+static void map_window_set_tile_pixel(rct_window *w, sint32 tileX, sint32 tileY)
+{
+	sint32 line = 0, i = 0;
+
+	switch (get_current_rotation()) {
+	case 0:
+		line = tileX;
+		i = tileY;
+		break;
+	case 1:
+		line = tileY;
+		i = 255 - tileX;
+		break;
+	case 2:
+		line = 255 - tileX;
+		i = 255 - tileY;
+		break;
+	case 3:
+		line = 255 - tileY;
+		i = tileX;
+		break;
+	}
+	map_window_set_pixel(w, tileX * 32, tileY * 32, map_window_get_pixel_destination(line, i));
+}
+
+/**
+ * Redraws all tiles passed to window_map_invalidate_tile since the last update.
+ * @returns true if any tile was redrawn.
+ */
+static bool map_window_update_dirty_tiles(rct_window *w)
+{
+	if (!_mapHasDirtyTiles)
+		return false;
+
+	_mapHasDirtyTiles = false;
+	for (sint32 y = 0; y < 256; y++) {
+		if (!_mapDirtyRows[y])
+			continue;
+
+		_mapDirtyRows[y] = false;
+		for (sint32 block = 0; block < 256 / 32; block++) {
+			uint32 bits = _mapDirtyTiles[y][block];
+			_mapDirtyTiles[y][block] = 0;
+			for (sint32 x = block * 32; bits != 0; x++, bits >>= 1) {
+				if (bits & 1)
+					map_window_set_tile_pixel(w, x, y);
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Checks whether the main viewport has moved or been resized since the last call, i.e. whether
+ * the HUD rectangle needs to be repainted.
+ */
+static bool map_window_main_view_changed()
+{
+	rct_window *mainWindow = window_get_main();
+	if (mainWindow == NULL || mainWindow->viewport == NULL)
+		return false;
+
+	rct_viewport *viewport = mainWindow->viewport;
+	if (viewport->view_x == _mapLastViewX &&
+		viewport->view_y == _mapLastViewY &&
+		viewport->view_width == _mapLastViewWidth &&
+		viewport->view_height == _mapLastViewHeight
+	) {
+		return false;
+	}
+
+	_mapLastViewX = viewport->view_x;
+	_mapLastViewY = viewport->view_y;
+	_mapLastViewWidth = viewport->view_width;
+	_mapLastViewHeight = viewport->view_height;
+	return true;
 }
 
 static void map_window_screen_to_map(sint32 screenX, sint32 screenY, sint32 *mapX, sint32 *mapY)
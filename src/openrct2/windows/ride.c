@@ -5480,8 +5480,11 @@ static void window_ride_graphs_update(rct_window *w)
 	w->frame_no++;
 	window_event_invalidate_call(w);
 	widget_invalidate(w, WIDX_TAB_8);
-	window_event_invalidate_call(w);
-	widget_invalidate(w, WIDX_GRAPH);
+
+	// Only redraw the graph when new measurements have been taken or it has scrolled
+	rct_ride *ride = get_ride(w->number);
+	bool graphChanged = (ride->window_invalidate_flags & RIDE_INVALIDATE_RIDE_GRAPH) != 0;
+	ride->window_invalidate_flags &= ~RIDE_INVALIDATE_RIDE_GRAPH;
 
 	widget = &window_ride_graphs_widgets[WIDX_GRAPH];
 	x = w->scrolls[0].h_left;
@@ -5492,8 +5495,17 @@ static void window_ride_graphs_update(rct_window *w)
 			measurement->current_item - (((widget->right - widget->left) / 4) * 3);
 	}
 
-	w->scrolls[0].h_left = clamp(0, x, w->scrolls[0].h_right - ((widget->right - widget->left) - 2));
+	x = clamp(0, x, w->scrolls[0].h_right - ((widget->right - widget->left) - 2));
+	if (x != w->scrolls[0].h_left) {
+		w->scrolls[0].h_left = x;
+		graphChanged = true;
+	}
 	widget_scroll_update_thumbs(w, WIDX_GRAPH);
+
+	if (graphChanged) {
+		window_event_invalidate_call(w);
+		widget_invalidate(w, WIDX_GRAPH);
+	}
 }
 
 /**
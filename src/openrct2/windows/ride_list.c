@@ -372,8 +372,9 @@ static void window_ride_list_update(rct_window *w)
 {
 	w->frame_no = (w->frame_no + 1) % 64;
 	widget_invalidate(w, WIDX_TAB_1 + w->page);
-	if (_window_ride_list_information_type != INFORMATION_TYPE_STATUS)
-		window_invalidate(w);
+
+	// Only redraw the list when one of the rides shown has changed
+	window_ride_list_refresh_list(w);
 }
 
 /**
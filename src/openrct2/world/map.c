@@ -496,6 +496,7 @@ void map_update_tile_pointers()
 	}
 
 	gNextFreeMapElement = mapElement;
+	viewport_hit_test_cache_clear();
 }
 
 /**
@@ -676,7 +677,9 @@ void sub_68B089()
 	if (mapElement == mapElementFirst)
 		return;
 
-	//
+	// The tile's elements are about to be moved in memory
+	viewport_hit_test_cache_clear();
+
 	gMapElementTilePointers[i] = mapElement;
 	do {
 		*mapElement = *mapElementFirst;
@@ -3181,6 +3184,8 @@ sint32 map_get_station(rct_map_element *mapElement)
  */
 void map_element_remove(rct_map_element *mapElement)
 {
+	viewport_hit_test_cache_clear();
+
 	// Replace Nth element by (N+1)th element.
 	// This loop will make mapElement point to the old last element position,
 	// after copy it to it's new position
@@ -3383,6 +3388,7 @@ rct_map_element *map_element_insert(sint32 x, sint32 y, sint32 z, sint32 flags)
 {
 	rct_map_element *originalMapElement, *newMapElement, *insertedElement;
 
+	viewport_hit_test_cache_clear();
 	if (!map_check_free_elements_and_reorganise(1)) {
 		log_error("Cannot insert new element");
 		return NULL;
@@ -4230,6 +4236,8 @@ static void map_invalidate_tile_under_zoom(sint32 x, sint32 y, sint32 z0, sint32
 	x2 = x + 32;
 	y2 = y + 32 - z0;
 
+	viewport_hit_test_cache_invalidate(x1, y1, x2, y2);
+
 	for (sint32 i = 0; i < MAX_VIEWPORT_COUNT; i++) {
 		rct_viewport *viewport = &g_viewport_list[i];
 		if (viewport->width != 0 && (maxZoom == -1 || viewport->zoom <= maxZoom)) {
@@ -4245,6 +4253,7 @@ static void map_invalidate_tile_under_zoom(sint32 x, sint32 y, sint32 z0, sint32
 void map_invalidate_tile(sint32 x, sint32 y, sint32 z0, sint32 z1)
 {
 	map_invalidate_tile_under_zoom(x, y, z0, z1, -1);
+	window_map_invalidate_tile(x, y);
 }
 
 /**
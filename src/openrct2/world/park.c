@@ -862,6 +862,7 @@ static money32 map_buy_land_rights_for_tile(sint32 x, sint32 y, sint32 setting,
 		}
 		if (flags & GAME_COMMAND_FLAG_APPLY) {
 			surfaceElement->properties.surface.ownership |= OWNERSHIP_OWNED;
+			window_map_invalidate_tile(x, y);
 			update_park_fences(x, y);
 			update_park_fences(x - 32, y);
 			update_park_fences(x + 32, y);
@@ -872,6 +873,7 @@ static money32 map_buy_land_rights_for_tile(sint32 x, sint32 y, sint32 setting,
 	case 1:
 		if (flags & GAME_COMMAND_FLAG_APPLY) {
 			surfaceElement->properties.surface.ownership &= ~(OWNERSHIP_OWNED | OWNERSHIP_CONSTRUCTION_RIGHTS_OWNED);
+			window_map_invalidate_tile(x, y);
 			update_park_fences(x, y);
 			update_park_fences(x - 32, y);
 			update_park_fences(x + 32, y);
@@ -960,6 +962,7 @@ static money32 map_buy_land_rights_for_tile(sint32 x, sint32 y, sint32 setting,
 		}
 		surfaceElement->properties.surface.ownership &= 0x0F;
 		surfaceElement->properties.surface.ownership |= newOwnership;
+		window_map_invalidate_tile(x, y);
 		update_park_fences(x, y);
 		update_park_fences(x - 32, y);
 		update_park_fences(x + 32, y);
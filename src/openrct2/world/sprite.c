@@ -67,10 +67,24 @@ uint16 sprite_get_first_in_quadrant(sint32 x, sint32 y)
 	return gSpriteSpatialIndex[offset];
 }
 
+static void sprite_invalidate_hit_test(rct_sprite *sprite)
+{
+	if (sprite->unknown.sprite_left == SPRITE_LOCATION_NULL) return;
+
+	viewport_hit_test_cache_invalidate(
+		sprite->unknown.sprite_left,
+		sprite->unknown.sprite_top,
+		sprite->unknown.sprite_right,
+		sprite->unknown.sprite_bottom
+	);
+}
+
 static void invalidate_sprite_max_zoom(rct_sprite *sprite, sint32 maxZoom)
 {
 	if (sprite->unknown.sprite_left == SPRITE_LOCATION_NULL) return;
 
+	sprite_invalidate_hit_test(sprite);
+
 	for (sint32 i = 0; i < MAX_VIEWPORT_COUNT; i++) {
 		rct_viewport *viewport = &g_viewport_list[i];
 		if (viewport->width != 0 && viewport->zoom <= maxZoom) {
@@ -538,9 +552,17 @@ void sprite_move(sint16 x, sint16 y, sint16 z, rct_sprite *sprite)
 		sint32 tempSpriteIndex = gSpriteSpatialIndex[newIndex];
 		gSpriteSpatialIndex[newIndex] = sprite->unknown.sprite_index;
 		sprite->unknown.next_in_quadrant = tempSpriteIndex;
+
+		// The minimap draws peeps and trains one pixel per tile
+		if (sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_PEEP ||
+			sprite->unknown.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE
+		) {
+			window_map_invalidate_sprites();
+		}
 	}
 
 	if (x == SPRITE_LOCATION_NULL) {
+		sprite_invalidate_hit_test(sprite);
 		sprite->unknown.sprite_left = SPRITE_LOCATION_NULL;
 		sprite->unknown.x = x;
 		sprite->unknown.y = y;
@@ -551,6 +573,9 @@ void sprite_move(sint16 x, sint16 y, sint16 z, rct_sprite *sprite)
 }
 
 void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
+	// Not every move is invalidated at all zoom levels, but picking must not see the old position
+	sprite_invalidate_hit_test(sprite);
+
 	sint16 new_x = x, new_y = y, start_x = x;
 	switch (get_current_rotation()){
 	case 0:
@@ -578,6 +603,8 @@ void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
 	sprite->unknown.x = x;
 	sprite->unknown.y = y;
 	sprite->unknown.z = z;
+
+	sprite_invalidate_hit_test(sprite);
 }
 
 /**
@@ -586,6 +613,7 @@ void sprite_set_coordinates(sint16 x, sint16 y, sint16 z, rct_sprite *sprite){
  */
 void sprite_remove(rct_sprite *sprite)
 {
+	viewport_hit_test_cache_clear();
 	move_sprite_to_list(sprite, SPRITE_LIST_NULL * 2);
 	user_string_free(sprite->unknown.name_string_idx);
 	sprite->unknown.sprite_identifier = SPRITE_IDENTIFIER_NULL;
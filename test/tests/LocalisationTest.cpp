@@ -0,0 +1,103 @@
+#include <memory>
+#include <gtest/gtest.h>
+#include "openrct2/config/Config.h"
+#include "openrct2/localisation/LanguagePack.h"
+
+extern "C"
+{
+    #include "openrct2/drawing/font.h"
+    #include "openrct2/localisation/localisation.h"
+}
+
+// format_string only needs the strings, config and dates, which are provided here instead of
+// loading a real language
+static std::unique_ptr<ILanguagePack> _languagePack;
+
+extern "C"
+{
+    GeneralConfiguration gConfigGeneral;
+    utf8 gUserStrings[MAX_USER_STRINGS * USER_STRING_MAX_LENGTH];
+
+    const char * language_get_string(rct_string_id id)
+    {
+        const utf8 * result = _languagePack->GetString(id);
+        return result != nullptr ? result : "";
+    }
+
+    bool font_supports_string(const utf8 * text, sint32 fontSize)
+    {
+        return true;
+    }
+
+    sint32 date_get_month(sint32 months)
+    {
+        return months % MONTH_COUNT;
+    }
+
+    sint32 date_get_year(sint32 months)
+    {
+        return months / MONTH_COUNT;
+    }
+}
+
+class LocalisationTest : public testing::Test
+{
+protected:
+    static const utf8 * Language;
+
+    void SetUp() override
+    {
+        _languagePack = std::unique_ptr<ILanguagePack>(LanguagePackFactory::FromText(0, Language));
+        format_string_cache_invalidate();
+    }
+
+    void TearDown() override
+    {
+        _languagePack = nullptr;
+    }
+};
+
+const utf8 * LocalisationTest::Language =
+    "STR_0779    :1st\n"
+    "STR_0780    :2nd\n"
+    "STR_2238    :March\n"
+    "STR_2239    :April\n"
+    "STR_2240    :May\n"
+    "STR_5151    :,\n"
+    "STR_5152    :.\n"
+    "STR_5550    :{POP16}{POP16}Year {COMMA16}, {PUSH16}{PUSH16}{MONTH} {PUSH16}{PUSH16}{STRINGID}\n"
+    "STR_5552    :{POP16}{POP16}Year {COMMA16}, {PUSH16}{PUSH16}{PUSH16}{STRINGID} {MONTH}\n";
+
+TEST_F(LocalisationTest, format_string)
+{
+    uint16 args[] = { STR_DATE_DAY_1, 0, 2 };
+    utf8 buffer[64];
+    format_string(buffer, sizeof(buffer), STR_DATE_FORMAT_YMD, args);
+    ASSERT_STREQ(buffer, "Year 2, March 1st");
+}
+
+TEST_F(LocalisationTest, format_string_cached_push16)
+{
+    // The arguments are read back to front, only the day comes first
+    uint16 args[] = { STR_DATE_DAY_1, 0, 2 };
+    utf8 buffer[64];
+    format_string(buffer, sizeof(buffer), STR_DATE_FORMAT_YMD, args);
+    ASSERT_STREQ(buffer, "Year 2, March 1st");
+    format_string(buffer, sizeof(buffer), STR_DATE_FORMAT_YMD, args);
+    ASSERT_STREQ(buffer, "Year 2, March 1st");
+
+    args[1] = 1;
+    format_string(buffer, sizeof(buffer), STR_DATE_FORMAT_YMD, args);
+    ASSERT_STREQ(buffer, "Year 2, April 1st");
+
+    args[2] = 3;
+    format_string(buffer, sizeof(buffer), STR_DATE_FORMAT_YMD, args);
+    ASSERT_STREQ(buffer, "Year 3, April 1st");
+
+    args[0] = STR_DATE_DAY_2;
+    format_string(buffer, sizeof(buffer), STR_DATE_FORMAT_YDM, args);
+    ASSERT_STREQ(buffer, "Year 3, 2nd April");
+    args[1] = 2;
+    format_string(buffer, sizeof(buffer), STR_DATE_FORMAT_YDM, args);
+    ASSERT_STREQ(buffer, "Year 3, 2nd May");
+}
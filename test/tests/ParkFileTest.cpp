@@ -0,0 +1,159 @@
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include "openrct2/core/IStream.hpp"
+#include "openrct2/core/MemoryStream.h"
+#include "openrct2/ParkFile.h"
+
+class ParkFileTest : public testing::Test
+{
+protected:
+    std::unique_ptr<rct_s6_data> _s6;
+    std::vector<uint8>           _packedObjects;
+
+    void SetUp() override
+    {
+        _s6 = std::unique_ptr<rct_s6_data>(new rct_s6_data());
+        uint8 * data = (uint8 *)_s6.get();
+        for (size_t i = 0; i < sizeof(rct_s6_data); i++)
+        {
+            data[i] = (uint8)((i * 31) ^ (i >> 9));
+        }
+        _s6->header.type = S6_TYPE_SAVEDGAME;
+
+        _packedObjects.resize(3000);
+        for (size_t i = 0; i < _packedObjects.size(); i++)
+        {
+            _packedObjects[i] = (uint8)(i * 7);
+        }
+    }
+
+    void WritePark(MemoryStream &ms)
+    {
+        ParkFile::Write(&ms, _s6.get(), _packedObjects.data(), _packedObjects.size());
+        ms.SetPosition(0);
+    }
+
+    static ParkFileSectionEntry * GetSectionEntry(MemoryStream &ms, uint32 id)
+    {
+        auto header = (ParkFileHeader *)ms.GetData();
+        auto entries = (ParkFileSectionEntry *)(header + 1);
+        for (uint16 i = 0; i < header->NumSections; i++)
+        {
+            if (entries[i].Id == id)
+            {
+                return &entries[i];
+            }
+        }
+        return nullptr;
+    }
+};
+
+TEST_F(ParkFileTest, write_read)
+{
+    MemoryStream ms;
+    WritePark(ms);
+    ASSERT_TRUE(ParkFile::IsParkFile(&ms));
+    ASSERT_EQ(ms.GetPosition(), 0);
+
+    auto s6 = std::unique_ptr<rct_s6_data>(new rct_s6_data());
+    std::vector<uint8> packedObjects;
+    ParkFile::Read(&ms, s6.get(), PARK_FILE_SECTION::MASK_ALL, &packedObjects);
+    ASSERT_EQ(ms.GetPosition(), ms.GetLength());
+    ASSERT_EQ(std::memcmp(s6.get(), _s6.get(), sizeof(rct_s6_data)), 0);
+    ASSERT_EQ(packedObjects, _packedObjects);
+}
+
+TEST_F(ParkFileTest, read_sections)
+{
+    MemoryStream ms;
+    WritePark(ms);
+
+    auto s6 = std::unique_ptr<rct_s6_data>(new rct_s6_data());
+    ParkFile::Read(&ms, s6.get(), (1 << PARK_FILE_SECTION::META) | (1 << PARK_FILE_SECTION::RIDES));
+    ASSERT_EQ(std::memcmp(&s6->header, &_s6->header, sizeof(rct_s6_header)), 0);
+    ASSERT_EQ(std::memcmp(&s6->info, &_s6->info, sizeof(rct_s6_info)), 0);
+    ASSERT_EQ(std::memcmp(s6->rides, _s6->rides, sizeof(rct_s6_data::rides)), 0);
+
+    rct_s6_data empty = { 0 };
+    ASSERT_EQ(std::memcmp(s6->map_elements, empty.map_elements, sizeof(rct_s6_data::map_elements)), 0);
+}
+
+TEST_F(ParkFileTest, read_meta)
+{
+    MemoryStream ms;
+    WritePark(ms);
+
+    rct_s6_header header;
+    rct_s6_info info;
+    ParkFile::ReadMeta(&ms, &header, &info);
+    ASSERT_EQ(std::memcmp(&header, &_s6->header, sizeof(rct_s6_header)), 0);
+    ASSERT_EQ(std::memcmp(&info, &_s6->info, sizeof(rct_s6_info)), 0);
+}
+
+TEST_F(ParkFileTest, not_a_park_file)
+{
+    uint8 data[64] = { 0 };
+    MemoryStream ms(data, sizeof(data));
+    ASSERT_FALSE(ParkFile::IsParkFile(&ms));
+
+    rct_s6_header header;
+    rct_s6_info info;
+    ASSERT_THROW(ParkFile::ReadMeta(&ms, &header, &info), IOException);
+}
+
+TEST_F(ParkFileTest, bad_crc)
+{
+    MemoryStream ms;
+    WritePark(ms);
+
+    ParkFileSectionEntry * entry = GetSectionEntry(ms, PARK_FILE_SECTION::MAP);
+    ASSERT_NE(entry, nullptr);
+    uint8 * sectionData = (uint8 *)ms.GetData() + entry->Offset;
+    sectionData[entry->CompressedLength / 2] ^= 0xFF;
+
+    auto s6 = std::unique_ptr<rct_s6_data>(new rct_s6_data());
+    ASSERT_THROW(ParkFile::Read(&ms, s6.get(), PARK_FILE_SECTION::MASK_ALL), IOException);
+
+    // Sections that are not read are not checked
+    ms.SetPosition(0);
+    rct_s6_header header;
+    rct_s6_info info;
+    ParkFile::ReadMeta(&ms, &header, &info);
+    ASSERT_EQ(std::memcmp(&info, &_s6->info, sizeof(rct_s6_info)), 0);
+}
+
+TEST_F(ParkFileTest, bad_length)
+{
+    MemoryStream ms;
+    WritePark(ms);
+
+    ParkFileSectionEntry * entry = GetSectionEntry(ms, PARK_FILE_SECTION::PARK);
+    ASSERT_NE(entry, nullptr);
+    entry->Length = UINT64_MAX;
+
+    auto s6 = std::unique_ptr<rct_s6_data>(new rct_s6_data());
+    ASSERT_THROW(ParkFile::Read(&ms, s6.get(), PARK_FILE_SECTION::MASK_ALL), IOException);
+
+    entry->Length = sizeof(rct_s6_data);
+    ms.SetPosition(0);
+    ASSERT_THROW(ParkFile::Read(&ms, s6.get(), PARK_FILE_SECTION::MASK_ALL), IOException);
+}
+
+TEST_F(ParkFileTest, truncated)
+{
+    MemoryStream ms;
+    WritePark(ms);
+
+    auto s6 = std::unique_ptr<rct_s6_data>(new rct_s6_data());
+    rct_s6_header header;
+    rct_s6_info info;
+    for (size_t length : { (size_t)4, sizeof(ParkFileHeader) + 10, (size_t)ms.GetLength() / 2, (size_t)ms.GetLength() - 1 })
+    {
+        MemoryStream truncated(ms.GetData(), length);
+        ASSERT_THROW(ParkFile::Read(&truncated, s6.get(), PARK_FILE_SECTION::MASK_ALL), IOException);
+        truncated.SetPosition(0);
+        ASSERT_THROW(ParkFile::ReadMeta(&truncated, &header, &info), IOException);
+    }
+}
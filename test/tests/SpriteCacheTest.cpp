@@ -0,0 +1,288 @@
+#include <cstring>
+#include <vector>
+#include <gtest/gtest.h>
+#include "openrct2/config/Config.h"
+
+extern "C"
+{
+    #include "openrct2/drawing/drawing.h"
+}
+
+// The sprite drawing only needs the palettes and a few sprites, which are provided here instead of
+// loading g1.dat. Image 0 is never drawn from the sprite cache, so it is used as the reference for
+// another image with the same data.
+static constexpr uint32 CachedImage = 1;
+static constexpr uint32 PaletteImageBase = 2;
+
+extern "C"
+{
+    GeneralConfiguration gConfigGeneral;
+    bool gOpenRCT2Headless = true;
+    uint8 gPeepPalette[256];
+    uint8 gOtherPalette[256];
+    void * unk_9E3CE4[8];
+    // Each palette is the image PaletteImageBase + its index
+    const uint16 palette_to_g1_offset[PALETTE_TO_G1_OFFSET_COUNT] = {
+        2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17,
+        18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33,
+        34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49,
+        50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65,
+        66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81,
+        82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97,
+        98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113,
+        114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129,
+        130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145,
+    };
+
+    // Only used by loading the graphics files, which the tests never do
+    const char * get_file_path(sint32 pathId) { return ""; }
+    void platform_get_openrct_data_path(utf8 * outPath, size_t outSize) { outPath[0] = '\0'; }
+    void platform_show_messagebox(const utf8 * message) { }
+    bool platform_file_exists(const utf8 * path) { return false; }
+    bool platform_file_copy(const utf8 * srcPath, const utf8 * dstPath, bool overwrite) { return false; }
+    bool platform_file_move(const utf8 * srcPath, const utf8 * dstPath) { return false; }
+    bool platform_file_delete(const utf8 * path) { return false; }
+}
+
+class SpriteCacheTest : public testing::Test
+{
+protected:
+    static constexpr sint32 ScreenWidth = 64;
+    static constexpr sint32 ScreenHeight = 48;
+
+    std::vector<rct_g1_element> _elements;
+    std::vector<std::vector<uint8>> _palettes;
+    std::vector<uint8> _rleData;
+    std::vector<uint8> _bmpData;
+
+    void SetUp() override
+    {
+        _elements.resize(PaletteImageBase + PALETTE_TO_G1_OFFSET_COUNT);
+        g1Elements = _elements.data();
+
+        // Some entries map to 0, which remapped bitmaps do not draw
+        _palettes.resize(PALETTE_TO_G1_OFFSET_COUNT);
+        for (size_t p = 0; p < _palettes.size(); p++)
+        {
+            _palettes[p].resize(256);
+            for (size_t i = 0; i < 256; i++)
+            {
+                _palettes[p][i] = (uint8)(i * (p + 3) + p);
+            }
+            rct_g1_element * element = &_elements[PaletteImageBase + p];
+            element->offset = _palettes[p].data();
+            element->width = 256;
+            element->height = 1;
+            element->flags = G1_FLAG_BMP;
+        }
+        for (size_t i = 0; i < 256; i++)
+        {
+            gPeepPalette[i] = (uint8)i;
+            gOtherPalette[i] = (uint8)i;
+        }
+    }
+
+    void TearDown() override
+    {
+        g1Elements = nullptr;
+    }
+
+    /**
+     * Sets both the reference and the cached image to an RLE sprite with runs of varying length
+     * and gaps in every row, using every pixel value but 0.
+     */
+    void SetRLESprite(sint16 width, sint16 height)
+    {
+        _rleData.assign(height * sizeof(uint16), 0);
+        for (sint32 y = 0; y < height; y++)
+        {
+            uint16 rowOffset = (uint16)_rleData.size();
+            std::memcpy(&_rleData[y * sizeof(uint16)], &rowOffset, sizeof(uint16));
+
+            sint32 x = (y * 5) % 7;
+            while (x < width)
+            {
+                sint32 length = std::min(3 + (x + y) % 6, width - x);
+                sint32 nextX = x + length + 1 + (x * y) % 4;
+                _rleData.push_back((uint8)(length | (nextX >= width ? 0x80 : 0)));
+                _rleData.push_back((uint8)x);
+                for (sint32 i = 0; i < length; i++)
+                {
+                    _rleData.push_back((uint8)(1 + ((x + i) * 31 + y * 17) % 255));
+                }
+                x = nextX;
+            }
+        }
+        SetSprite(_rleData.data(), width, height, G1_FLAG_RLE_COMPRESSION);
+    }
+
+    void SetBMPSprite(sint16 width, sint16 height)
+    {
+        _bmpData.resize(width * height);
+        for (size_t i = 0; i < _bmpData.size(); i++)
+        {
+            _bmpData[i] = (uint8)(i * 29);
+        }
+        SetSprite(_bmpData.data(), width, height, 0);
+    }
+
+    void SetSprite(uint8 * data, sint16 width, sint16 height, uint16 flags)
+    {
+        for (uint32 image : { (uint32)0, CachedImage })
+        {
+            rct_g1_element * element = &_elements[image];
+            element->offset = data;
+            element->width = width;
+            element->height = height;
+            element->x_offset = -5;
+            element->y_offset = -7;
+            element->flags = flags;
+            element->zoomed_offset = 0;
+        }
+
+        // The data may have been reallocated at the same address
+        gfx_invalidate_remapped_sprite(CachedImage);
+    }
+
+    /**
+     * Draws the image with the given colours through the sprite cache and directly, and checks
+     * that the same pixels are drawn.
+     */
+    static void AssertDrawnEqual(uint32 colours, sint32 x, sint32 y, uint32 tertiaryColour = 0, sint32 zoomLevel = 0)
+    {
+        std::vector<uint8> expected = Draw(colours, x, y, tertiaryColour, zoomLevel);
+        std::vector<uint8> actual = Draw(colours | CachedImage, x, y, tertiaryColour, zoomLevel);
+        ASSERT_EQ(actual, expected) << "colours " << std::hex << colours << std::dec << " at " << x << ", " << y << " zoom " << zoomLevel;
+    }
+
+    static std::vector<uint8> Draw(uint32 imageId, sint32 x, sint32 y, uint32 tertiaryColour, sint32 zoomLevel)
+    {
+        std::vector<uint8> bits(ScreenWidth * ScreenHeight);
+        for (size_t i = 0; i < bits.size(); i++)
+        {
+            bits[i] = (uint8)(i * 7);
+        }
+
+        rct_drawpixelinfo dpi;
+        dpi.bits = bits.data();
+        dpi.x = 0;
+        dpi.y = 0;
+        dpi.width = ScreenWidth << zoomLevel;
+        dpi.height = ScreenHeight << zoomLevel;
+        dpi.pitch = 0;
+        dpi.zoom_level = zoomLevel;
+        gfx_draw_sprite_software(&dpi, imageId, x, y, tertiaryColour);
+        return bits;
+    }
+};
+
+// Each combination of colours that is part of the palette key
+static const uint32 RemapColours[] =
+{
+    IMAGE_TYPE_REMAP | (3 << 19),
+    IMAGE_TYPE_REMAP | (100 << 19),
+    IMAGE_TYPE_REMAP_2_PLUS | IMAGE_TYPE_REMAP | (4 << 19) | (9 << 24),
+    IMAGE_TYPE_REMAP_2_PLUS | IMAGE_TYPE_REMAP | (9 << 19) | (4 << 24),
+    IMAGE_TYPE_REMAP_2_PLUS | (4 << 19) | (9 << 24),
+    IMAGE_TYPE_REMAP_2_PLUS | (31 << 19) | (0 << 24),
+};
+
+TEST_F(SpriteCacheTest, remap_rle)
+{
+    SetRLESprite(37, 29);
+    for (uint32 colours : RemapColours)
+    {
+        // The first draw fills the cache, the second one draws from it
+        AssertDrawnEqual(colours, 20, 20, 12);
+        AssertDrawnEqual(colours, 20, 20, 12);
+    }
+}
+
+TEST_F(SpriteCacheTest, remap_bmp)
+{
+    SetBMPSprite(23, 17);
+    for (uint32 colours : RemapColours)
+    {
+        AssertDrawnEqual(colours, 20, 20, 12);
+        AssertDrawnEqual(colours, 20, 20, 12);
+    }
+}
+
+TEST_F(SpriteCacheTest, remap_clipped)
+{
+    SetRLESprite(37, 29);
+    for (uint32 colours : RemapColours)
+    {
+        AssertDrawnEqual(colours, 0, 2, 12);
+        AssertDrawnEqual(colours, 50, 40, 12);
+    }
+
+    SetBMPSprite(23, 17);
+    for (uint32 colours : RemapColours)
+    {
+        AssertDrawnEqual(colours, 0, 2, 12);
+        AssertDrawnEqual(colours, 50, 40, 12);
+    }
+}
+
+TEST_F(SpriteCacheTest, remap_tertiary_colour)
+{
+    // The tertiary colour is only part of the palette without IMAGE_TYPE_REMAP
+    SetRLESprite(37, 29);
+    for (uint32 tertiaryColour : { 12, 13, 143, 12 })
+    {
+        AssertDrawnEqual(IMAGE_TYPE_REMAP_2_PLUS | (4 << 19) | (9 << 24), 20, 20, tertiaryColour);
+        AssertDrawnEqual(IMAGE_TYPE_REMAP_2_PLUS | IMAGE_TYPE_REMAP | (4 << 19) | (9 << 24), 20, 20, tertiaryColour);
+    }
+}
+
+TEST_F(SpriteCacheTest, zoomed_rle)
+{
+    SetRLESprite(37, 29);
+    for (sint32 zoomLevel = 1; zoomLevel <= 3; zoomLevel++)
+    {
+        // Every row phase and column alignment of the sprite at each zoom level
+        for (sint32 i = 0; i < (1 << zoomLevel); i++)
+        {
+            sint32 x = (20 << zoomLevel) + i;
+            sint32 y = (20 << zoomLevel) + i;
+            AssertDrawnEqual(0, x, y, 0, zoomLevel);
+            AssertDrawnEqual(0, x, y, 0, zoomLevel);
+        }
+    }
+}
+
+TEST_F(SpriteCacheTest, zoomed_rle_clipped)
+{
+    SetRLESprite(37, 29);
+    for (sint32 zoomLevel = 1; zoomLevel <= 3; zoomLevel++)
+    {
+        for (sint32 i = 0; i < (1 << zoomLevel); i++)
+        {
+            sint32 right = (ScreenWidth << zoomLevel) - 10 + i;
+            sint32 bottom = (ScreenHeight << zoomLevel) - 10 + i;
+            sint32 middle = (20 << zoomLevel) + i;
+
+            // Top, bottom and right, then left which is drawn without the cache
+            AssertDrawnEqual(0, middle, 3 + i, 0, zoomLevel);
+            AssertDrawnEqual(0, middle, bottom, 0, zoomLevel);
+            AssertDrawnEqual(0, right, middle, 0, zoomLevel);
+            AssertDrawnEqual(0, right, bottom, 0, zoomLevel);
+            AssertDrawnEqual(0, 2 + i, middle, 0, zoomLevel);
+        }
+    }
+}
+
+TEST_F(SpriteCacheTest, zoomed_remapped)
+{
+    SetRLESprite(37, 29);
+    for (sint32 zoomLevel = 1; zoomLevel <= 3; zoomLevel++)
+    {
+        for (uint32 colours : RemapColours)
+        {
+            sint32 middle = (20 << zoomLevel) + 1;
+            AssertDrawnEqual(colours, middle, middle, 12, zoomLevel);
+            AssertDrawnEqual(colours, middle, 3, 12, zoomLevel);
+        }
+    }
+}
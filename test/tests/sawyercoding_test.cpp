@@ -98,6 +98,95 @@ TEST_F(SawyerCodingTest, decode_chunk_rotate)
     test_decode(rotatedata, sizeof(rotatedata));
 }
 
+TEST_F(SawyerCodingTest, encode_chunk_rlecompressed_golden)
+{
+    // Encoded output must stay byte for byte the same as RCT2's
+    sawyercoding_chunk_header chdr_in;
+    chdr_in.encoding = CHUNK_ENCODING_RLECOMPRESSED;
+    chdr_in.length = sizeof(randomdata);
+    uint8 * encodedDataBuffer = new uint8[BUFFER_SIZE];
+    size_t encodedDataSize = sawyercoding_write_chunk_buffer(encodedDataBuffer, randomdata, chdr_in);
+    ASSERT_EQ(encodedDataSize, sizeof(rlecompresseddata));
+    ASSERT_EQ(memcmp(encodedDataBuffer, rlecompresseddata, sizeof(rlecompresseddata)), 0);
+    delete[] encodedDataBuffer;
+}
+
+TEST_F(SawyerCodingTest, encode_chunk_rlecompressed_repeats_golden)
+{
+    // Data with plenty of repeats both inside and just outside the 32 byte window
+    uint8 * data = new uint8[65536];
+    uint32 seed = 1;
+    for (size_t i = 0; i < 65536; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        uint32 r = seed >> 16;
+        if ((i & 64) && i >= 40)
+        {
+            data[i] = data[i - 1 - (r % 40)];
+        }
+        else
+        {
+            data[i] = (uint8)(r & 7);
+        }
+    }
+
+    sawyercoding_chunk_header chdr_in;
+    chdr_in.encoding = CHUNK_ENCODING_RLECOMPRESSED;
+    chdr_in.length = 65536;
+    uint8 * encodedDataBuffer = new uint8[BUFFER_SIZE];
+    size_t encodedDataSize = sawyercoding_write_chunk_buffer(encodedDataBuffer, data, chdr_in);
+    ASSERT_EQ(encodedDataSize, 44277u);
+    ASSERT_EQ(sawyercoding_calculate_checksum(encodedDataBuffer, encodedDataSize), 0x003DCD3Au);
+    delete[] encodedDataBuffer;
+    delete[] data;
+}
+
+TEST_F(SawyerCodingTest, decode_buffer_size)
+{
+    const uint8 * chunks[] = { nonedata, rledata, rlecompresseddata, rotatedata };
+    for (const uint8 * data : chunks)
+    {
+        sawyercoding_chunk_header chdr_in;
+        memcpy(&chdr_in, data, sizeof(sawyercoding_chunk_header));
+        size_t bufferSize;
+        ASSERT_TRUE(sawyercoding_get_decode_buffer_size(data + sizeof(sawyercoding_chunk_header), chdr_in, &bufferSize));
+        if (chdr_in.encoding == CHUNK_ENCODING_RLECOMPRESSED)
+        {
+            ASSERT_GE(bufferSize, sizeof(randomdata));
+        }
+        else
+        {
+            ASSERT_EQ(bufferSize, sizeof(randomdata));
+        }
+
+        uint8 * decodeBuffer = new uint8[bufferSize];
+        size_t decodedDataSize = sawyercoding_read_chunk_buffer(decodeBuffer, data + sizeof(sawyercoding_chunk_header), chdr_in, bufferSize);
+        ASSERT_EQ(decodedDataSize, sizeof(randomdata));
+        ASSERT_EQ(memcmp(decodeBuffer, randomdata, sizeof(randomdata)), 0);
+        delete[] decodeBuffer;
+    }
+}
+
+TEST_F(SawyerCodingTest, decode_buffer_size_truncated)
+{
+    sawyercoding_chunk_header chdr_in;
+    memcpy(&chdr_in, rledata, sizeof(sawyercoding_chunk_header));
+    chdr_in.length -= 1;
+    size_t bufferSize;
+    ASSERT_FALSE(sawyercoding_get_decode_buffer_size(rledata + sizeof(sawyercoding_chunk_header), chdr_in, &bufferSize));
+}
+
+TEST_F(SawyerCodingTest, update_checksum_in_parts)
+{
+    uint32 expected = sawyercoding_calculate_checksum(randomdata, sizeof(randomdata));
+    uint32 checksum = 0;
+    checksum = sawyercoding_update_checksum(checksum, randomdata, 1);
+    checksum = sawyercoding_update_checksum(checksum, randomdata + 1, 0);
+    checksum = sawyercoding_update_checksum(checksum, randomdata + 1, 500);
+    checksum = sawyercoding_update_checksum(checksum, randomdata + 501, sizeof(randomdata) - 501);
+    ASSERT_EQ(checksum, expected);
+}
+
 // 1024 bytes of random data
 // use `dd if=/dev/urandom bs=1024 count=1 | xxd -i` to get your own
 const uint8 SawyerCodingTest::randomdata[] = {